@@ -4,6 +4,15 @@ Linear Search
 
 Complexity: Theta(n)
 
+Besides the plain scalar loop, the array can be scanned with SIMD
+instructions (8 floats per compare with AVX2, 4 with SSE2; other types of
+Dtype use the scalar loop) and, for arrays larger than the last level cache,
+by several threads each scanning a contiguous chunk. In that case the scan is
+bound by memory bandwidth, not by the compare loop. Apart from the first match, all the matches can be counted
+or their indices written out compactly.
+
+Compile with -O2 -march=native -pthread to enable AVX2 and threads.
+
 Author: Sandeep Palakkal 
 Email: sandeep.dion@gmail.com
 13-Aug-2016
@@ -15,6 +24,14 @@ Email: sandeep.dion@gmail.com
 #include <cstddef>
 #include <ctime>
 #include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <unistd.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -22,6 +39,17 @@ using namespace std;
 typedef float Dtype;
 //typedef char Dtype;
 
+//Only float arrays are scanned with SIMD compares. Other types take the
+//scalar loops.
+const bool SIMD_DTYPE = is_same<Dtype, float>::value;
+
+//Search modes
+enum SEARCH_MODE {FIRST, COUNT, FIND_ALL};
+
+//Number of elements scanned by a thread before it checks whether an earlier
+//match was found by another thread
+const int BLOCK_LEN = 1 << 14;
+
 
 /**
   Linear search
@@ -41,6 +69,272 @@ int linear_search(Dtype *array, int array_len, Dtype value)
 }
 
 
+/**
+  Returns the bitmask of elements equal to value among the SIMD_WIDTH
+  elements starting at array. Called only if SIMD_DTYPE (Dtype is float).
+  */
+#if defined(__AVX2__)
+const int SIMD_WIDTH = 8;
+inline unsigned int simd_match(const Dtype *array, __m256 value_v)
+{
+    __m256 a = _mm256_loadu_ps((const float *)array);
+    return _mm256_movemask_ps(_mm256_cmp_ps(a, value_v, _CMP_EQ_OQ));
+}
+#elif defined(__SSE2__)
+const int SIMD_WIDTH = 4;
+inline unsigned int simd_match(const Dtype *array, __m128 value_v)
+{
+    __m128 a = _mm_loadu_ps((const float *)array);
+    return _mm_movemask_ps(_mm_cmpeq_ps(a, value_v));
+}
+#endif
+
+
+/**
+  Linear search using SIMD compares. Four vectors are compared per iteration
+  and the loop exits as soon as any of them has a match.
+  */
+int linear_search_simd(const Dtype *array, int beg, int end, Dtype value)
+{
+    int i = beg;
+#if defined(__AVX2__) || defined(__SSE2__)
+#if defined(__AVX2__)
+    __m256 value_v = _mm256_set1_ps(value);
+#else
+    __m128 value_v = _mm_set1_ps(value);
+#endif
+    for(; SIMD_DTYPE && i + 4 * SIMD_WIDTH <= end; i += 4 * SIMD_WIDTH)
+    {
+        unsigned int m0 = simd_match(array + i, value_v);
+        unsigned int m1 = simd_match(array + i + SIMD_WIDTH, value_v);
+        unsigned int m2 = simd_match(array + i + 2 * SIMD_WIDTH, value_v);
+        unsigned int m3 = simd_match(array + i + 3 * SIMD_WIDTH, value_v);
+        if(m0 | m1 | m2 | m3)
+        {
+            unsigned long long m = m0 | (m1 << SIMD_WIDTH) |
+                ((unsigned long long)m2 << (2 * SIMD_WIDTH)) |
+                ((unsigned long long)m3 << (3 * SIMD_WIDTH));
+            return i + __builtin_ctzll(m);
+        }
+    }
+    for(; SIMD_DTYPE && i + SIMD_WIDTH <= end; i += SIMD_WIDTH)
+    {
+        unsigned int m = simd_match(array + i, value_v);
+        if(m) return i + __builtin_ctz(m);
+    }
+#endif
+    for(; i < end; ++i)
+    {
+        if(array[i] == value) return i;
+    }
+    return -1;
+}
+
+
+/**
+  Count the elements equal to value in [beg, end)
+  */
+long long linear_count_simd(const Dtype *array, int beg, int end, Dtype value)
+{
+    long long count = 0;
+    int i = beg;
+#if defined(__AVX2__) || defined(__SSE2__)
+#if defined(__AVX2__)
+    __m256 value_v = _mm256_set1_ps(value);
+#else
+    __m128 value_v = _mm_set1_ps(value);
+#endif
+    for(; SIMD_DTYPE && i + SIMD_WIDTH <= end; i += SIMD_WIDTH)
+    {
+        count += __builtin_popcount(simd_match(array + i, value_v));
+    }
+#endif
+    for(; i < end; ++i)
+    {
+        count += (array[i] == value);
+    }
+    return count;
+}
+
+
+/**
+  Write the indices of all the elements equal to value in [beg, end) to
+  indices and return their number.
+  */
+int linear_find_all_simd(const Dtype *array, int beg, int end, Dtype value,
+        int *indices)
+{
+    int n = 0;
+    int i = beg;
+#if defined(__AVX2__) || defined(__SSE2__)
+#if defined(__AVX2__)
+    __m256 value_v = _mm256_set1_ps(value);
+#else
+    __m128 value_v = _mm_set1_ps(value);
+#endif
+    for(; SIMD_DTYPE && i + SIMD_WIDTH <= end; i += SIMD_WIDTH)
+    {
+        unsigned int m = simd_match(array + i, value_v);
+        while(m)
+        {
+            indices[n++] = i + __builtin_ctz(m);
+            m &= m - 1;
+        }
+    }
+#endif
+    for(; i < end; ++i)
+    {
+        if(array[i] == value) indices[n++] = i;
+    }
+    return n;
+}
+
+
+/**
+  Size of the last level cache in bytes
+  */
+long llc_size()
+{
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    long size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if(size > 0) return size;
+#endif
+    return 8L << 20;
+}
+
+
+/**
+  Number of threads to use for scanning array_len elements. Arrays which fit
+  in the last level cache are scanned by a single thread.
+  */
+int scan_threads(int array_len)
+{
+    if((long)array_len * (long)sizeof(Dtype) <= llc_size()) return 1;
+    int n_threads = thread::hardware_concurrency();
+    return n_threads > 0 ? n_threads : 1;
+}
+
+
+/**
+  Multithreaded linear search. Each thread scans a contiguous chunk block by
+  block and stops once a match before its current block is known. Returns the
+  first match.
+  */
+int linear_search_parallel(const Dtype *array, int array_len, Dtype value,
+        int n_threads)
+{
+    if(n_threads <= 1)
+    {
+        return linear_search_simd(array, 0, array_len, value);
+    }
+    atomic<int> first(array_len);
+    thread *threads = new thread[n_threads];
+    int chunk = (array_len + n_threads - 1) / n_threads;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        int beg = t * chunk;
+        int end = (beg + chunk < array_len) ? beg + chunk : array_len;
+        threads[t] = thread([=, &first]()
+        {
+            for(int b = beg; b < end; b += BLOCK_LEN)
+            {
+                if(first.load(memory_order_relaxed) < b) return;
+                int e = (b + BLOCK_LEN < end) ? b + BLOCK_LEN : end;
+                int pos = linear_search_simd(array, b, e, value);
+                if(pos != -1)
+                {
+                    int cur = first.load();
+                    while(pos < cur && !first.compare_exchange_weak(cur, pos));
+                    return;
+                }
+            }
+        });
+    }
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+    }
+    delete[] threads;
+    int pos = first.load();
+    return pos < array_len ? pos : -1;
+}
+
+
+/**
+  Multithreaded count of elements equal to value
+  */
+long long linear_count_parallel(const Dtype *array, int array_len,
+        Dtype value, int n_threads)
+{
+    if(n_threads <= 1)
+    {
+        return linear_count_simd(array, 0, array_len, value);
+    }
+    long long *counts = new long long[n_threads];
+    thread *threads = new thread[n_threads];
+    int chunk = (array_len + n_threads - 1) / n_threads;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        int beg = t * chunk < array_len ? t * chunk : array_len;
+        int end = (beg + chunk < array_len) ? beg + chunk : array_len;
+        threads[t] = thread([=]()
+        {
+            counts[t] = linear_count_simd(array, beg, end, value);
+        });
+    }
+    long long count = 0;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+        count += counts[t];
+    }
+    delete[] threads;
+    delete[] counts;
+    return count;
+}
+
+
+/**
+  Multithreaded find all. indices must have room for array_len entries. Each
+  thread writes the matches of its chunk from the position of the chunk in
+  indices. The results are then moved together. Returns the number of matches.
+  */
+int linear_find_all_parallel(const Dtype *array, int array_len, Dtype value,
+        int *indices, int n_threads)
+{
+    if(n_threads <= 1)
+    {
+        return linear_find_all_simd(array, 0, array_len, value, indices);
+    }
+    int *counts = new int[n_threads];
+    thread *threads = new thread[n_threads];
+    int chunk = (array_len + n_threads - 1) / n_threads;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        int beg = t * chunk < array_len ? t * chunk : array_len;
+        int end = (beg + chunk < array_len) ? beg + chunk : array_len;
+        threads[t] = thread([=]()
+        {
+            counts[t] = linear_find_all_simd(array, beg, end, value,
+                    indices + beg);
+        });
+    }
+    int n = 0;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+        int beg = t * chunk;
+        for(int k = 0; k < counts[t]; ++k)
+        {
+            indices[n++] = indices[beg + k];
+        }
+    }
+    delete[] threads;
+    delete[] counts;
+    return n;
+}
+
+
 /**
   Read input array from terminal
   */
@@ -95,6 +389,8 @@ void usage(char *exe_file)
         " input_file.)" << endl;
     cout << "3. " << exe_file << "<input_file> <output_file> (Reads"\
         " input from input_file and writes output to output_file.)\n";
+    cout << "After the value to be searched for, the search mode is read:"\
+        " first match, count or find all.\n";
 }
 
 int main(int argc, char **argv)
@@ -109,7 +405,7 @@ int main(int argc, char **argv)
         }
     }
 
-    int array_len;
+    int array_len = 0;
     Dtype *array {nullptr};
     Dtype value;
 
@@ -130,15 +426,60 @@ int main(int argc, char **argv)
     //Read the element to be searched
     cout << "Enter the value to be searched for: ";
     cin >> value;
-    
-    //Call search algorithm
-    clock_t time = clock();
-    int pos = linear_search(array, array_len, value);
-    time = clock() - time;
-    cout << "Linear search took "<< 
-        float(time) / CLOCKS_PER_SEC * 1000 << " ms." << endl;
-
-    if(pos != -1)
+
+    //Get the search mode
+    cout << "Select search mode:\n";
+    cout << "1. FIRST\n2. COUNT\n3. FIND_ALL\n";
+    short mode_;
+    cin >> mode_;
+    if(mode_ < 1 || mode_ > 3)
+    {
+        cout << "Unkown choice\n";
+        delete[] array;
+        return 1;
+    }
+    SEARCH_MODE mode = (mode_ == 1) ? FIRST : (mode_ == 2) ? COUNT : FIND_ALL;
+    int n_threads = scan_threads(array_len);
+
+    //Wall clock time, since several threads may be used
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    int pos = -1;
+    long long count = 0;
+    int *indices = nullptr;
+    switch(mode)
+    {
+        case FIRST:
+            pos = linear_search_parallel(array, array_len, value, n_threads);
+            break;
+        case COUNT:
+            count = linear_count_parallel(array, array_len, value,
+                    n_threads);
+            break;
+        case FIND_ALL:
+            indices = new int[array_len > 0 ? array_len : 1];
+            count = linear_find_all_parallel(array, array_len, value,
+                    indices, n_threads);
+            break;
+    }
+    chrono::duration<double, milli> time = chrono::steady_clock::now() - t0;
+    cout << "Linear search took "<< time.count() << " ms using " <<
+        n_threads << " thread(s)." << endl;
+
+    if(mode == COUNT)
+    {
+        cout << "Searched value appears " << count << " time(s)\n";
+    }
+    else if(mode == FIND_ALL)
+    {
+        cout << "Searched value appears " << count << " time(s) at:";
+        for(int i = 0; i < count; ++i)
+        {
+            cout << " " << indices[i] + 1;
+        }
+        cout << endl;
+        delete[] indices;
+    }
+    else if(pos != -1)
     {    
         cout << "Searched value appears at: " << pos + 1 << endl;
         cout << "Array[" << pos << "] = " << setprecision(6) << fixed
@@ -11,6 +11,20 @@ size to be searched by half every time. So, algorithm is log n.
 
 Complexity: Theta(log n)
 
+Two other search methods are given for sorted arrays:
+
+Interpolation search probes where the value is expected to be if the keys
+were uniformly spread between the two ends of the current range. For nearly
+uniform keys, this takes about log log n probes. For adversarial keys,
+interpolation may shrink the range by only one element per probe. So, when a
+probe fails to halve the range, the next probe is a bisection, which limits
+the worst case to about 2 log n probes.
+
+Exponential (galloping) search starts from a hint position (e.g., the
+position of the previous hit) and probes at distances 1, 2, 4, ... until the
+value is bracketed. Then it runs binary search in the bracket. It takes about
+2 log d probes, where d is the distance of the value from the hint.
+
 Author: Sandeep Palakkal 
 Email: sandeep.dion@gmail.com
 13-Aug-2016
@@ -57,12 +71,18 @@ bool compare(const Dtype a, const Dtype b, const SORT_TYPE sort_type)
 }
 
 
+//search method
+enum SEARCH_METHOD {BINARY, INTERPOLATION, EXPONENTIAL};
+
+
 /**
-  Binary search
+  Binary search. probes is incremented for every array element compared.
   */
-int binary_search(Dtype *array, int beg, int end, Dtype value, SORT_TYPE sort_type)
+int binary_search(Dtype *array, int beg, int end, Dtype value, SORT_TYPE
+        sort_type, int &probes)
 {
     if(end == beg) return -1;
+    ++probes;
     if(end - beg == 1)
     {
         return (array[beg] == value) ? beg : -1;
@@ -74,15 +94,25 @@ int binary_search(Dtype *array, int beg, int end, Dtype value, SORT_TYPE sort_ty
     }
     if(compare(array[mid], value, sort_type))
     {
-        return binary_search(array, beg, mid, value, sort_type);
+        return binary_search(array, beg, mid, value, sort_type, probes);
     }
     else
     {
-        return binary_search(array, mid, end, value, sort_type);
+        return binary_search(array, mid, end, value, sort_type, probes);
     }
 }
 
 
+/**
+  Binary search
+  */
+int binary_search(Dtype *array, int beg, int end, Dtype value, SORT_TYPE sort_type)
+{
+    int probes = 0;
+    return binary_search(array, beg, end, value, sort_type, probes);
+}
+
+
 /**
   Boilerplate function for binary search
   */
@@ -92,6 +122,127 @@ int binary_search(Dtype *array, int array_len, Dtype value, SORT_TYPE sort_type)
 }
 
 
+/**
+  Interpolation search guarded by bisection
+  */
+int interpolation_search(Dtype *array, int array_len, Dtype value, SORT_TYPE
+        sort_type, int &probes)
+{
+    int lo = 0, hi = array_len - 1;
+    bool bisect = false;
+    //Only the reads of the two ends of the whole array are counted as
+    //probes. The later ends are next to a probed element.
+    probes += 2;
+    while(lo <= hi)
+    {
+        //The value must lie between the two ends of the range
+        if(compare(array[lo], value, sort_type) ||
+                compare(value, array[hi], sort_type))
+        {
+            return -1;
+        }
+        int mid;
+        if(bisect || array[hi] == array[lo])
+        {
+            mid = lo + (hi - lo) / 2;
+        }
+        else
+        {
+            double frac = (double(value) - array[lo]) /
+                (double(array[hi]) - array[lo]);
+            mid = lo + int(frac * (hi - lo));
+            if(mid < lo) mid = lo;
+            if(mid > hi) mid = hi;
+        }
+        ++probes;
+        if(array[mid] == value)
+        {
+            return mid;
+        }
+        int len = hi - lo + 1;
+        if(compare(array[mid], value, sort_type))
+        {
+            hi = mid - 1;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+        //Fall back to bisection if the range did not halve
+        bisect = (hi - lo + 1) > len / 2;
+    }
+    return -1;
+}
+
+
+/**
+  Exponential (galloping) search starting from the position hint
+  */
+int exponential_search(Dtype *array, int array_len, Dtype value, int hint,
+        SORT_TYPE sort_type, int &probes)
+{
+    if(array_len <= 0) return -1;
+    if(hint < 0) hint = 0;
+    if(hint >= array_len) hint = array_len - 1;
+
+    ++probes;
+    if(array[hint] == value) return hint;
+    int bound = 1;
+    int beg, end;
+    if(compare(array[hint], value, sort_type))
+    {
+        //Value lies before hint. Gallop to the left.
+        while(hint - bound >= 0)
+        {
+            ++probes;
+            Dtype a = array[hint - bound];
+            if(a == value) return hint - bound;
+            if(!compare(a, value, sort_type)) break;
+            bound *= 2;
+        }
+        beg = (hint - bound + 1 > 0) ? hint - bound + 1 : 0;
+        end = hint - bound / 2;
+    }
+    else
+    {
+        //Value lies after hint. Gallop to the right.
+        while(hint + bound < array_len)
+        {
+            ++probes;
+            Dtype a = array[hint + bound];
+            if(a == value) return hint + bound;
+            if(compare(a, value, sort_type)) break;
+            bound *= 2;
+        }
+        beg = hint + bound / 2 + 1;
+        end = (hint + bound < array_len) ? hint + bound : array_len;
+    }
+    if(beg >= end) return -1;
+    return binary_search(array, beg, end, value, sort_type, probes);
+}
+
+
+/**
+  Search using the selected method
+  */
+int search(Dtype *array, int array_len, Dtype value, SORT_TYPE sort_type,
+        SEARCH_METHOD method, int hint, int &probes)
+{
+    switch(method)
+    {
+        case INTERPOLATION:
+            return interpolation_search(array, array_len, value, sort_type,
+                    probes);
+        case EXPONENTIAL:
+            return exponential_search(array, array_len, value, hint,
+                    sort_type, probes);
+        default:
+            return binary_search(array, 0, array_len, value, sort_type,
+                    probes);
+    }
+}
+
+
 /**
   Read input array from terminal
   */
@@ -146,6 +297,9 @@ void usage(char *exe_file)
         " input_file.)" << endl;
     cout << "3. " << exe_file << "<input_file> <output_file> (Reads"\
         " input from input_file and writes output to output_file.)\n";
+    cout << "After the value to be searched for, the search method is read:"\
+        " binary, interpolation or exponential. Exponential search also"\
+        " reads the position (1, ..., n) to start from.\n";
 }
 
 int main(int argc, char **argv)
@@ -175,7 +329,7 @@ int main(int argc, char **argv)
     sort_type = (sort_type_ == 1)? ASCEND : DESCEND;
 
 
-    int array_len;
+    int array_len = 0;
     Dtype *array {nullptr};
     Dtype value;
 
@@ -196,13 +350,36 @@ int main(int argc, char **argv)
     //Read the element to be searched
     cout << "Enter the value to be searched for: ";
     cin >> value;
+
+    //Get the search method
+    cout << "Select search method:\n";
+    cout << "1. BINARY\n2. INTERPOLATION\n3. EXPONENTIAL\n";
+    short method_;
+    cin >> method_;
+    if(method_ < 1 || method_ > 3)
+    {
+        cout << "Unkown choice\n";
+        delete[] array;
+        return 1;
+    }
+    SEARCH_METHOD method = (method_ == 1) ? BINARY : (method_ == 2) ?
+        INTERPOLATION : EXPONENTIAL;
+    int hint = 0;
+    if(method == EXPONENTIAL)
+    {
+        cout << "Enter the position to start from: ";
+        cin >> hint;
+        --hint;
+    }
     
     //Call search algorithm
+    int probes = 0;
     clock_t time = clock();
-    int pos = binary_search(array, array_len, value, sort_type);
+    int pos = search(array, array_len, value, sort_type, method, hint, probes);
     time = clock() - time;
-    cout << "Binary search took "<< 
-        float(time) / CLOCKS_PER_SEC * 1000 << " ms." << endl;
+    cout << "Search took "<< 
+        float(time) / CLOCKS_PER_SEC * 1000 << " ms and " << probes <<
+        " probes." << endl;
 
     if(pos != -1)
     {    
@@ -14,11 +14,44 @@ Created: 14-Aug-2016
 #include <iomanip>
 #include <fstream>
 #include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <cmath>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
 typedef int Dtype;
 
+//solve3 uses a dense bitset if the value range is at most this many times the
+//array length (i.e., at most 4 bytes per element). Otherwise it uses a hash
+//set, whose memory is proportional to the array length.
+const long long DENSE_RANGE_FACTOR = 32;
+
+//Structure built once by the batch mode to answer many targets
+enum BATCH_METHOD {BATCH_SORTED = 1, BATCH_HASH = 2, BATCH_BITSET = 3};
+
+//Number of targets taken by a thread at a time in the batch mode
+const int BATCH_CHUNK = 64;
+
+//Number of pairs buffered by each thread before writing them out in the
+//all-pairs mode
+const int PAIR_BUF_LEN = 1 << 16;
+
+//Largest bitset the automatic selection may allocate
+const long long BITSET_MAX_BYTES = 1LL << 28;
+
+//Array length used to calibrate the cost model
+const int CALIBRATION_LEN = 1 << 16;
+
 /**
   Binary search algorithm
   */
@@ -108,7 +141,57 @@ void merge_sort(Dtype *array1, Dtype *array2, int array_len)
     }
     Dtype *array3 = new Dtype [array_len];
     merge_sort(array2, array3, 0, array_len);
-    delete array3;
+    delete[] array3;
+}
+
+/**
+  Part of merge sort of positions. Merges two runs of positions according to
+  the values at them.
+  */
+void merge_positions(const Dtype *array, int *pos, int *buf, int beg, int mid,
+        int end)
+{
+    int i = beg, j = mid, k = beg;
+    while(i < mid && j < end)
+    {
+        if(array[pos[i]] > array[pos[j]])
+        {
+            buf[k++] = pos[j++];
+        }
+        else
+        {
+            buf[k++] = pos[i++];
+        }
+    }
+    while(i < mid)
+    {
+        buf[k++] = pos[i++];
+    }
+    while(j < end)
+    {
+        buf[k++] = pos[j++];
+    }
+    for(i = beg; i < end; ++i)
+    {
+        pos[i] = buf[i];
+    }
+}
+
+/**
+  Merge sort of positions: sorts pos so that array[pos[k]] is ascending. The
+  array itself is not modified. Equal values keep their order.
+  */
+void merge_sort_positions(const Dtype *array, int *pos, int *buf, int beg,
+        int end)
+{
+    if(end - beg <= 1)
+    {
+        return;
+    }
+    int mid = (beg + end) / 2;
+    merge_sort_positions(array, pos, buf, beg, mid);
+    merge_sort_positions(array, pos, buf, mid, end);
+    merge_positions(array, pos, buf, beg, mid, end);
 }
 
 /**
@@ -125,6 +208,297 @@ void findrange(Dtype *array, int array_len, int &min, int &max)
 }
 
 
+/**
+  Open addressing hash set of Dtype keys (SwissTable layout)
+
+  Slots are grouped into groups of 16. Each slot has a control byte, which is
+  EMPTY or the low 7 bits of the hash of the key in the slot. The control
+  bytes of a group are compared with the 7 bit hash of the searched key in
+  one SSE2 instruction, so that only the slots whose control byte matches are
+  compared with the key. Probing moves from group to group (triangular
+  sequence) until a group with an empty slot is found. Keys are never
+  removed. Capacity is kept so that the load factor is at most 7/8.
+  */
+const signed char EMPTY = -128;
+const int GROUP = 16;
+
+struct HashSet
+{
+    signed char *ctrl;
+    Dtype *slots;
+    unsigned long long n_groups; //power of 2
+};
+
+
+/**
+  Hash function (multiplicative, with the high bits folded down)
+  */
+inline unsigned long long hash_key(Dtype key)
+{
+    unsigned long long h = (unsigned long long)(long long)key *
+        0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 29);
+}
+
+
+/**
+  Bitmask of the slots in the group at ctrl whose control byte is c
+  */
+inline unsigned int group_match(const signed char *ctrl, signed char c)
+{
+#ifdef __SSE2__
+    __m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(c)));
+#else
+    unsigned int mask = 0;
+    for(int i = 0; i < GROUP; ++i)
+    {
+        if(ctrl[i] == c) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+
+/**
+  Allocate a hash set which can hold n keys
+  */
+bool hash_set_init(HashSet &set, int n)
+{
+    unsigned long long slots_needed = (unsigned long long)n * 8 / 7 + 1;
+    set.n_groups = 1;
+    while(set.n_groups * GROUP < slots_needed) set.n_groups *= 2;
+    set.ctrl = new (nothrow) signed char[set.n_groups * GROUP];
+    set.slots = new (nothrow) Dtype[set.n_groups * GROUP];
+    if(set.ctrl == nullptr || set.slots == nullptr)
+    {
+        delete[] set.ctrl;
+        delete[] set.slots;
+        set.ctrl = nullptr;
+        set.slots = nullptr;
+        return false;
+    }
+    memset(set.ctrl, EMPTY, set.n_groups * GROUP);
+    return true;
+}
+
+
+/**
+  Free the hash set
+  */
+void hash_set_free(HashSet &set)
+{
+    delete[] set.ctrl;
+    delete[] set.slots;
+    set.ctrl = nullptr;
+    set.slots = nullptr;
+}
+
+
+/**
+  Returns true if key is in the set
+  */
+bool hash_set_contains(const HashSet &set, Dtype key)
+{
+    unsigned long long h = hash_key(key);
+    signed char h2 = h & 0x7F;
+    unsigned long long mask = set.n_groups - 1;
+    unsigned long long g = (h >> 7) & mask;
+    for(unsigned long long step = 1; ; ++step)
+    {
+        const signed char *ctrl = set.ctrl + g * GROUP;
+        const Dtype *slots = set.slots + g * GROUP;
+        for(unsigned int m = group_match(ctrl, h2); m; m &= m - 1)
+        {
+            if(slots[__builtin_ctz(m)] == key) return true;
+        }
+        if(group_match(ctrl, EMPTY)) return false;
+        g = (g + step) & mask;
+    }
+}
+
+
+/**
+  Insert key into the set if it is not there. Returns false if it was there.
+  */
+bool hash_set_insert(HashSet &set, Dtype key)
+{
+    unsigned long long h = hash_key(key);
+    signed char h2 = h & 0x7F;
+    unsigned long long mask = set.n_groups - 1;
+    unsigned long long g = (h >> 7) & mask;
+    for(unsigned long long step = 1; ; ++step)
+    {
+        signed char *ctrl = set.ctrl + g * GROUP;
+        Dtype *slots = set.slots + g * GROUP;
+        for(unsigned int m = group_match(ctrl, h2); m; m &= m - 1)
+        {
+            if(slots[__builtin_ctz(m)] == key) return false;
+        }
+        unsigned int empty = group_match(ctrl, EMPTY);
+        if(empty)
+        {
+            int i = __builtin_ctz(empty);
+            ctrl[i] = h2;
+            slots[i] = key;
+            return true;
+        }
+        g = (g + step) & mask;
+    }
+}
+
+
+/**
+  Build a bitset of the values (1 bit per value in [min, max]). If dups is not
+  nullptr, the values which appear more than once are marked in it.
+  */
+void bitset_build(const Dtype *array, int array_len, int min,
+        unsigned int *bits, unsigned int *dups)
+{
+    for(int i = 0; i < array_len; ++i)
+    {
+        unsigned int off = (unsigned int)array[i] - (unsigned int)min;
+        unsigned int bit = 1u << (off & 31);
+        if(dups != nullptr && (bits[off >> 5] & bit))
+        {
+            dups[off >> 5] |= bit;
+        }
+        bits[off >> 5] |= bit;
+    }
+}
+
+
+/**
+  Returns true if the value x / 2 can be paired with itself, i.e., it appears
+  at least twice. dups is used if available; otherwise the array is counted.
+  */
+bool self_pair_ok(const Dtype *array, int array_len, Dtype half, int min,
+        const unsigned int *dups)
+{
+    if(dups != nullptr)
+    {
+        unsigned int off = (unsigned int)half - (unsigned int)min;
+        return (dups[off >> 5] >> (off & 31)) & 1;
+    }
+    int count = 0;
+    for(int i = 0; i < array_len && count < 2; ++i)
+    {
+        count += (array[i] == half);
+    }
+    return count >= 2;
+}
+
+
+/**
+  Check for a pair summing to x using the bitset of the values. The
+  complement x - a of every element a is probed. With AVX2, 8 complements are
+  probed at a time with a gather of the bitset words.
+
+  Since every value is in the bitset, the complement of a can be a itself.
+  This is a valid pair only if the value x / 2 appears at least twice.
+
+  On success, k is set to the index of a in the array, and a and b are set
+  to the pair.
+  */
+bool bitset_probe(const Dtype *array, int array_len, Dtype x, int min,
+        long long range, const unsigned int *bits, const unsigned int *dups,
+        int &k, Dtype &a, Dtype &b)
+{
+    //Elements whose complement can be in [min, max] lie in [lo, hi]. For
+    //them, the offset of the complement is c - a, which fits in 32 bits.
+    long long c = (long long)x - min;
+    long long lo = (c - range + 1 > min) ? c - range + 1 : min;
+    long long hi = (c < min + range - 1) ? c : min + range - 1;
+    if(lo > hi) return false;
+
+    //-1: not checked yet, 0: no, 1: yes
+    int self_ok = -1;
+    int i = 0;
+#ifdef __AVX2__
+    __m256i lo_v = _mm256_set1_epi32(int(lo) - 1);
+    __m256i hi_v = _mm256_set1_epi32(int(hi) + 1);
+    __m256i c_v = _mm256_set1_epi32(int((unsigned int)c));
+    __m256i mod_v = _mm256_set1_epi32(31);
+    __m256i one_v = _mm256_set1_epi32(1);
+    for(; i + 8 <= array_len; i += 8)
+    {
+        __m256i a_v = _mm256_loadu_si256((const __m256i *)(array + i));
+        __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi32(a_v, lo_v),
+                _mm256_cmpgt_epi32(hi_v, a_v));
+        if(_mm256_testz_si256(in_range, in_range)) continue;
+        __m256i off = _mm256_sub_epi32(c_v, a_v);
+        __m256i word = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                (const int *)bits, _mm256_srli_epi32(off, 5), in_range, 4);
+        __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word,
+                    _mm256_and_si256(off, mod_v)), one_v);
+        bit = _mm256_and_si256(bit, in_range);
+        unsigned int m = _mm256_movemask_ps(_mm256_castsi256_ps(
+                    _mm256_cmpeq_epi32(bit, one_v)));
+
+        //Candidates. Reject an element paired with itself.
+        for(; m; m &= m - 1)
+        {
+            int l = i + __builtin_ctz(m);
+            if((long long)array[l] * 2 == x)
+            {
+                if(self_ok == -1)
+                {
+                    self_ok = self_pair_ok(array, array_len, array[l], min,
+                            dups);
+                }
+                if(!self_ok) continue;
+            }
+            k = l;
+            a = array[l];
+            b = Dtype((long long)x - array[l]);
+            return true;
+        }
+    }
+#endif
+    for(; i < array_len; ++i)
+    {
+        if(array[i] < lo || array[i] > hi) continue;
+        unsigned int off = (unsigned int)c - (unsigned int)array[i];
+        if(!((bits[off >> 5] >> (off & 31)) & 1)) continue;
+        if((long long)array[i] * 2 == x)
+        {
+            if(self_ok == -1)
+            {
+                self_ok = self_pair_ok(array, array_len, array[i], min, dups);
+            }
+            if(!self_ok) continue;
+        }
+        k = i;
+        a = array[i];
+        b = Dtype((long long)x - array[i]);
+        return true;
+    }
+    return false;
+}
+
+
+/**
+  Check for a pair summing to x using a bitset of the values. On success, a
+  and b are set to the pair.
+  */
+bool bitset_two_sum(const Dtype *array, int array_len, Dtype x, int min,
+        long long range, Dtype &a, Dtype &b)
+{
+    unsigned int *bits = new (nothrow) unsigned int[(range + 31) / 32]{};
+    if(bits == nullptr)
+    {
+        cout << "Solve3: Out of memory\n";
+        return false;
+    }
+    bitset_build(array, array_len, min, bits, nullptr);
+    int k;
+    bool found = bitset_probe(array, array_len, x, min, range, bits, nullptr,
+            k, a, b);
+    delete[] bits;
+    return found;
+}
+
+
 /**
   Solve the problem (method 1)
   Sort and binary search
@@ -159,7 +533,7 @@ void solve1(Dtype *array, int array_len, Dtype x)
     //Delete memory
     if(array_srt != nullptr)
     {
-        delete array_srt;
+        delete[] array_srt;
     }
 }
 
@@ -200,15 +574,64 @@ void solve2(Dtype *array, int array_len, Dtype x)
     //Delete memory
     if(array_sort != nullptr)
     {
-        delete array_sort;
+        delete[] array_sort;
     }
 }
 
+/**
+  Check for a pair summing to x in one pass with a hash set of the elements
+  seen so far. On success, a and b are set to the pair.
+  */
+bool hash_two_sum(const Dtype *array, int array_len, Dtype x, int min,
+        int max, Dtype &a, Dtype &b)
+{
+    HashSet set;
+    if(!hash_set_init(set, array_len))
+    {
+        cout << "Solve3: Out of memory\n";
+        return false;
+    }
+    bool success = false;
+    for(int i = 0; i < array_len; ++i)
+    {
+        long long diff = (long long)x - array[i];
+        if(diff >= min && diff <= max && hash_set_contains(set, Dtype(diff)))
+        {
+            a = array[i];
+            b = Dtype(diff);
+            success = true;
+            break;
+        }
+        hash_set_insert(set, array[i]);
+    }
+    hash_set_free(set);
+    return success;
+}
+
+
+/**
+  Print the result of solve3
+  */
+void print_two_sum(Dtype x, bool success, Dtype a, Dtype b)
+{
+    if(success)
+    {
+        cout << x << " can be factored as " << a << " + " << b << endl;
+    }
+    else
+    {
+        cout << x << " cannot be written as sums of any two numbers in the "\
+            "given array." << endl;
+    }
+}
+
+
 /**
   Solve problem (Method 3)
   Uses hashing
   Complexity: n
-  Memory requirement: max - min
+  Memory requirement: (max - min) / 8 bytes if the range is small (bitset),
+  otherwise proportional to n (hash set)
 */
 void solve3(Dtype *array, int array_len, Dtype x)
 {
@@ -217,42 +640,683 @@ void solve3(Dtype *array, int array_len, Dtype x)
         cout << "The given array is empty. I cannot process.\n";
         return;
     }
-    int min, max, range;
+    int min, max;
     findrange(array, array_len, min, max);
-    range = max - min + 1;
-    bool *table;
-    if(!(table = new bool [range]{}))
+    long long range = (long long)max - min + 1;
+    bool success = false;
+    Dtype a, b;
+    if(range <= DENSE_RANGE_FACTOR * array_len)
     {
-        cout << "Solve3: Out of memory\n";
+        cout << "Solve3: using dense bitset" << endl;
+        success = bitset_two_sum(array, array_len, x, min, range, a, b);
+    }
+    else
+    {
+        cout << "Solve3: using hash set" << endl;
+        success = hash_two_sum(array, array_len, x, min, max, a, b);
+    }
+    print_two_sum(x, success, a, b);
+}
+
+
+/**
+  Cost model of the methods. Each entry is the time in ns per unit of work:
+  sort and search per n log2 n, sweep, bitset and hash per element, and
+  clear per 32 bit word of the bitset.
+  */
+struct CostModel
+{
+    double sort;
+    double search;
+    double sweep;
+    double bitset;
+    double clear;
+    double hash;
+};
+
+//Methods the automatic selection chooses from
+enum AUTO_METHOD {AUTO_SEARCH, AUTO_SWEEP, AUTO_BITSET, AUTO_HASH};
+const char *AUTO_METHOD_NAME[] = {"sort + binary search",
+    "sort + two pointers", "bitset", "hash set"};
+
+
+/**
+  File in which the cost model of this host is kept
+  */
+string cost_model_file()
+{
+    const char *home = getenv("HOME");
+    return string(home != nullptr ? home : ".") + "/.two_sum_cost_model";
+}
+
+
+/**
+  Time the pieces of the methods on a random array to calibrate the cost
+  model. All the values are even and x is odd, so that no pair is found and
+  every method does its full work. Each piece is timed 3 times and the
+  fastest is kept.
+  */
+void calibrate_cost_model(CostModel &model)
+{
+    const int n = CALIBRATION_LEN;
+    const double n_log_n = n * log2(double(n));
+    Dtype *array = new Dtype[n];
+    Dtype *array_sort = new Dtype[n];
+    for(int i = 0; i < n; ++i)
+    {
+        array[i] = 2 * (rand() % (2 * n));
+    }
+    int min, max;
+    findrange(array, n, min, max);
+    long long range = (long long)max - min + 1;
+    const Dtype x = 4 * n + 1;
+    const int n_words = 1 << 20;
+    double t[6] = {1e300, 1e300, 1e300, 1e300, 1e300, 1e300};
+    Dtype a, b;
+    volatile int sink = 0;
+    for(int rep = 0; rep < 3; ++rep)
+    {
+        clock_t t0 = clock();
+        merge_sort(array, array_sort, n);
+        t[0] = fmin(t[0], double(clock() - t0));
+
+        t0 = clock();
+        for(int i = 0; i < n; ++i)
+        {
+            sink += binary_search(x - array_sort[i], array_sort, i + 1, n);
+        }
+        t[1] = fmin(t[1], double(clock() - t0));
+
+        t0 = clock();
+        int i = 0, j = n - 1;
+        while(i < j)
+        {
+            if(array_sort[i] + array_sort[j] < x) ++i;
+            else --j;
+        }
+        sink += i;
+        t[2] = fmin(t[2], double(clock() - t0));
+
+        t0 = clock();
+        sink += bitset_two_sum(array, n, x, min, range, a, b);
+        t[3] = fmin(t[3], double(clock() - t0));
+
+        t0 = clock();
+        unsigned int *words = new unsigned int[n_words]{};
+        sink += words[rand() % n_words];
+        delete[] words;
+        t[4] = fmin(t[4], double(clock() - t0));
+
+        t0 = clock();
+        sink += hash_two_sum(array, n, x, min, max, a, b);
+        t[5] = fmin(t[5], double(clock() - t0));
+    }
+    const double ns = 1e9 / CLOCKS_PER_SEC;
+    model.sort = t[0] * ns / n_log_n;
+    model.search = t[1] * ns / n_log_n;
+    model.sweep = t[2] * ns / n;
+    model.clear = t[4] * ns / n_words;
+    model.bitset = fmax(t[3] * ns - model.clear * range / 32, 0.0) / n;
+    model.hash = t[5] * ns / n;
+    delete[] array;
+    delete[] array_sort;
+}
+
+
+/**
+  Load the cost model of this host. If there is none, calibrate it and save
+  it for the next runs.
+  */
+void get_cost_model(CostModel &model)
+{
+    string filename = cost_model_file();
+    ifstream ifp {filename};
+    if(ifp >> model.sort >> model.search >> model.sweep >> model.bitset >>
+            model.clear >> model.hash)
+    {
+        return;
+    }
+    cout << "Calibrating the cost model for this host... ";
+    calibrate_cost_model(model);
+    ofstream ofp {filename};
+    if(ofp.is_open())
+    {
+        ofp << model.sort << " " << model.search << " " << model.sweep << " "
+            << model.bitset << " " << model.clear << " " << model.hash << endl;
+        cout << "saved in " << filename << endl;
+    }
+    else
+    {
+        cout << "could not be saved" << endl;
+    }
+}
+
+
+/**
+  Fraction of duplicates in an evenly spaced sample of the array
+  */
+double sample_duplicate_rate(const Dtype *array, int array_len)
+{
+    int n_sample = (array_len < 4096) ? array_len : 4096;
+    if(n_sample < 2) return 0;
+    Dtype *sample = new Dtype[n_sample];
+    Dtype *sample_sort = new Dtype[n_sample];
+    for(int i = 0; i < n_sample; ++i)
+    {
+        sample[i] = array[(long long)i * array_len / n_sample];
+    }
+    merge_sort(sample, sample_sort, n_sample);
+    int n_dup = 0;
+    for(int i = 1; i < n_sample; ++i)
+    {
+        n_dup += (sample_sort[i] == sample_sort[i - 1]);
+    }
+    delete[] sample;
+    delete[] sample_sort;
+    return double(n_dup) / n_sample;
+}
+
+
+/**
+  Solve the problem with the method which the cost model predicts to be the
+  fastest for the input. The decision, the predicted time and the actual time
+  are logged.
+  */
+void solve_auto(Dtype *array, int array_len, Dtype x, const CostModel &model)
+{
+    if(array_len == 0)
+    {
+        cout << "The given array is empty. I cannot process.\n";
         return;
     }
-   
-    //Hash and search
+    int min, max;
+    findrange(array, array_len, min, max);
+    long long range = (long long)max - min + 1;
+    double dup_rate = sample_duplicate_rate(array, array_len);
+
+    //Predicted time in ms of each method. Duplicates shrink the number of
+    //keys stored in the hash set.
+    double n = array_len, n_log_n = n * log2(n > 1 ? n : 2);
+    double cost[4];
+    cost[AUTO_SEARCH] = n_log_n * (model.sort + model.search) * 1e-6;
+    cost[AUTO_SWEEP] = (n_log_n * model.sort + n * model.sweep) * 1e-6;
+    cost[AUTO_BITSET] = (range / 8 <= BITSET_MAX_BYTES) ? (n * model.bitset +
+            range / 32.0 * model.clear) * 1e-6 : 1e300;
+    cost[AUTO_HASH] = n * (1 - dup_rate / 2) * model.hash * 1e-6;
+    int best = AUTO_SEARCH;
+    for(int m = 1; m < 4; ++m)
+    {
+        if(cost[m] < cost[best]) best = m;
+    }
+    cout << "Auto: n = " << array_len << ", range = " << range <<
+        ", duplicate rate = " << dup_rate << endl;
+    cout << "Auto: predicted time (ms):";
+    for(int m = 0; m < 4; ++m)
+    {
+        cout << (m > 0 ? ", " : " ") << AUTO_METHOD_NAME[m] << " = ";
+        if(cost[m] < 1e300) cout << cost[m];
+        else cout << "(too much memory)";
+    }
+    cout << endl;
+    cout << "Auto: using " << AUTO_METHOD_NAME[best] << endl;
+
+    clock_t t0 = clock();
     bool success = false;
-    for(int i = 0; i < array_len; ++i)
+    Dtype a, b;
+    switch(best)
+    {
+        case AUTO_SEARCH:
+            solve1(array, array_len, x);
+            break;
+        case AUTO_SWEEP:
+            solve2(array, array_len, x);
+            break;
+        case AUTO_BITSET:
+            success = bitset_two_sum(array, array_len, x, min, range, a, b);
+            print_two_sum(x, success, a, b);
+            break;
+        default:
+            success = hash_two_sum(array, array_len, x, min, max, a, b);
+            print_two_sum(x, success, a, b);
+            break;
+    }
+    cout << "Auto: predicted " << cost[best] << " ms, actual " <<
+        float(clock() - t0)/CLOCKS_PER_SEC*1000 << " ms\n";
+}
+
+/**
+  Result of a target in the batch mode. i and j are the (0-based) positions
+  of the pair in the input array, or -1 if there is no pair.
+  */
+struct PairRecord
+{
+    int found;
+    int i;
+    int j;
+};
+
+
+/**
+  Structure built once from the array, to answer many targets
+  */
+struct TwoSumIndex
+{
+    BATCH_METHOD method;
+    Dtype *array;
+    int array_len;
+    int min, max;
+    long long range;
+    Dtype *sorted;      //BATCH_SORTED: sorted copy
+    HashSet set;        //BATCH_HASH: values
+    HashSet dup_set;    //BATCH_HASH: values appearing more than once
+    unsigned int *bits; //BATCH_BITSET: values
+    unsigned int *dups; //BATCH_BITSET: values appearing more than once
+};
+
+
+/**
+  Build the structure for the batch mode
+  */
+bool two_sum_index_build(Dtype *array, int array_len, BATCH_METHOD method,
+        TwoSumIndex &index)
+{
+    index.method = method;
+    index.array = array;
+    index.array_len = array_len;
+    index.sorted = nullptr;
+    index.bits = index.dups = nullptr;
+    index.set.ctrl = index.dup_set.ctrl = nullptr;
+    index.set.slots = index.dup_set.slots = nullptr;
+    if(array_len == 0) return true;
+    findrange(array, array_len, index.min, index.max);
+    index.range = (long long)index.max - index.min + 1;
+
+    switch(method)
     {
-        int diff = x - array[i];
-        if(diff >= min && diff <= max && table[diff - min])
+        case BATCH_SORTED:
+            index.sorted = new Dtype[array_len];
+            merge_sort(array, index.sorted, array_len);
+            break;
+        case BATCH_HASH:
+            if(!hash_set_init(index.set, array_len) ||
+                    !hash_set_init(index.dup_set, array_len))
+            {
+                return false;
+            }
+            for(int i = 0; i < array_len; ++i)
+            {
+                if(!hash_set_insert(index.set, array[i]))
+                {
+                    hash_set_insert(index.dup_set, array[i]);
+                }
+            }
+            break;
+        case BATCH_BITSET:
+            index.bits = new (nothrow) unsigned int[(index.range + 31) / 32]{};
+            index.dups = new (nothrow) unsigned int[(index.range + 31) / 32]{};
+            if(index.bits == nullptr || index.dups == nullptr)
+            {
+                return false;
+            }
+            bitset_build(array, array_len, index.min, index.bits, index.dups);
+            break;
+    }
+    return true;
+}
+
+
+/**
+  Free the structure of the batch mode
+  */
+void two_sum_index_free(TwoSumIndex &index)
+{
+    delete[] index.sorted;
+    delete[] index.bits;
+    delete[] index.dups;
+    hash_set_free(index.set);
+    hash_set_free(index.dup_set);
+}
+
+
+/**
+  Find the positions of the pair of values (a, b) in the array. The position
+  of a is k if it is known (k != -1).
+  */
+void find_pair_positions(const Dtype *array, int array_len, Dtype a, Dtype b,
+        int k, PairRecord &record)
+{
+    record.i = k;
+    record.j = -1;
+    for(int l = 0; l < array_len && (record.i == -1 || record.j == -1); ++l)
+    {
+        if(record.i == -1 && array[l] == a)
         {
-            cout << x << " can be factored as " << array[i] << " + " <<
-                diff << endl;
-            success = true;
+            record.i = l;
+        }
+        else if(record.j == -1 && array[l] == b && l != record.i)
+        {
+            record.j = l;
+        }
+    }
+}
+
+
+/**
+  Answer one target using the structure
+  */
+PairRecord two_sum_index_query(const TwoSumIndex &index, Dtype x)
+{
+    PairRecord record = {0, -1, -1};
+    Dtype a = 0, b = 0;
+    int k = -1;
+    const Dtype *array = index.array;
+    int array_len = index.array_len;
+    if(array_len == 0) return record;
+
+    switch(index.method)
+    {
+        case BATCH_SORTED:
+        {
+            int i = 0, j = array_len - 1;
+            while(i < j)
+            {
+                long long sum = (long long)index.sorted[i] + index.sorted[j];
+                if(sum < x) ++i;
+                else if(sum > x) --j;
+                else
+                {
+                    a = index.sorted[i];
+                    b = index.sorted[j];
+                    record.found = 1;
+                    break;
+                }
+            }
             break;
         }
-        table[array[i] - min] = true;
+        case BATCH_HASH:
+            for(int i = 0; i < array_len; ++i)
+            {
+                long long diff = (long long)x - array[i];
+                if(diff < index.min || diff > index.max ||
+                        !hash_set_contains(index.set, Dtype(diff)))
+                {
+                    continue;
+                }
+                if(diff == array[i] && !hash_set_contains(index.dup_set,
+                            array[i]))
+                {
+                    continue;
+                }
+                k = i;
+                a = array[i];
+                b = Dtype(diff);
+                record.found = 1;
+                break;
+            }
+            break;
+        case BATCH_BITSET:
+            record.found = bitset_probe(array, array_len, x, index.min,
+                    index.range, index.bits, index.dups, k, a, b);
+            break;
     }
-    if(!success)
+    if(record.found)
     {
-        cout << x << " cannot be written as sums of any two numbers in the "\
-            "given array." << endl;
+        find_pair_positions(array, array_len, a, b, k, record);
     }
+    return record;
+}
+
 
-    if(table != nullptr)
+/**
+  Answer all the targets using n_threads threads. Threads take chunks of
+  targets from a shared counter.
+  */
+void two_sum_batch(const TwoSumIndex &index, const Dtype *targets,
+        int n_targets, PairRecord *records, int n_threads)
+{
+    atomic<int> next(0);
+    thread *threads = new thread[n_threads];
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t] = thread([&]()
+        {
+            int beg;
+            while((beg = next.fetch_add(BATCH_CHUNK)) < n_targets)
+            {
+                int end = (beg + BATCH_CHUNK < n_targets) ? beg + BATCH_CHUNK :
+                    n_targets;
+                for(int q = beg; q < end; ++q)
+                {
+                    records[q] = two_sum_index_query(index, targets[q]);
+                }
+            }
+        });
+    }
+    for(int t = 0; t < n_threads; ++t)
     {
-        delete table;
+        threads[t].join();
     }
+    delete[] threads;
 }
 
+
+/**
+  Write the records to a binary file
+  */
+bool write_records_file(const string filename, const PairRecord *records,
+        int n_records)
+{
+    ofstream ofp {filename, ios::binary};
+    if(!ofp.is_open())
+    {
+        cout << "Unable to open the result file\n";
+        return false;
+    }
+    ofp.write((const char *)records, sizeof(PairRecord) * n_records);
+    ofp.close();
+    return true;
+}
+
+
+/**
+  Buffered writer of pairs, shared by several threads. Each thread fills its
+  own buffer and writes it to the file in one piece under the lock. So, the
+  pairs of different threads are interleaved in blocks.
+  */
+struct PairWriter
+{
+    ofstream *ofp;
+    mutex *lock;
+    int *buf;
+    int len;
+};
+
+
+/**
+  Write out the pairs buffered in writer
+  */
+void pair_writer_flush(PairWriter &writer)
+{
+    if(writer.len == 0) return;
+    lock_guard<mutex> guard(*writer.lock);
+    writer.ofp->write((const char *)writer.buf, sizeof(int) * 2 * writer.len);
+    writer.len = 0;
+}
+
+
+/**
+  Add pair (i, j) to writer
+  */
+inline void pair_writer_add(PairWriter &writer, int i, int j)
+{
+    writer.buf[2 * writer.len] = i < j ? i : j;
+    writer.buf[2 * writer.len + 1] = i < j ? j : i;
+    if(++writer.len == PAIR_BUF_LEN)
+    {
+        pair_writer_flush(writer);
+    }
+}
+
+
+/**
+  Returns the first k in [beg, end) such that array[pos[k]] > value
+  */
+int upper_bound_positions(const Dtype *array, const int *pos, int beg,
+        int end, long long value)
+{
+    while(beg < end)
+    {
+        int mid = beg + (end - beg) / 2;
+        if(array[pos[mid]] <= value) beg = mid + 1;
+        else end = mid;
+    }
+    return beg;
+}
+
+
+/**
+  Two pointer sweep over one segment. pos sorts the array. The left pointer
+  moves over the runs of equal values starting in [lb, le), all of which have
+  values v <= x - v. The right pointer starts from the last value not greater
+  than the complement of the first value, and moves down. Every pair is
+  counted, with equal values counted with multiplicity. If writer is not
+  nullptr, every pair of positions is written to it.
+  */
+long long all_pairs_segment(const Dtype *array, const int *pos,
+        int array_len, Dtype x, int lb, int le, PairWriter *writer)
+{
+    long long count = 0;
+    if(lb >= le) return 0;
+    int j = upper_bound_positions(array, pos, 0, array_len,
+            (long long)x - array[pos[lb]]) - 1;
+    int i = lb;
+    while(i < le)
+    {
+        Dtype v = array[pos[i]];
+        int ie = i + 1;
+        while(ie < array_len && array[pos[ie]] == v) ++ie;
+        long long w = (long long)x - v;
+        while(j >= 0 && array[pos[j]] > w) --j;
+        if(j >= 0 && array[pos[j]] == w)
+        {
+            int js = j;
+            while(js > 0 && array[pos[js - 1]] == w) --js;
+            if(w == v)
+            {
+                //Pairs within the run
+                long long c = ie - i;
+                count += c * (c - 1) / 2;
+                for(int p = i; writer != nullptr && p < ie; ++p)
+                {
+                    for(int q = p + 1; q < ie; ++q)
+                    {
+                        pair_writer_add(*writer, pos[p], pos[q]);
+                    }
+                }
+            }
+            else
+            {
+                //Pairs across the two runs
+                count += (long long)(ie - i) * (j + 1 - js);
+                for(int p = i; writer != nullptr && p < ie; ++p)
+                {
+                    for(int q = js; q <= j; ++q)
+                    {
+                        pair_writer_add(*writer, pos[p], pos[q]);
+                    }
+                }
+            }
+            j = js - 1;
+        }
+        i = ie;
+    }
+    return count;
+}
+
+
+/**
+  Count (and enumerate, if ofilename is not empty) all the pairs of positions
+  whose values add to x. The left half of the sorted array (values v with
+  2v <= x) is split into n_threads segments at run boundaries. Each segment is
+  co-ranked with the right pointer by a binary search, so the segments are
+  swept independently by the threads.
+  */
+long long all_pairs(const Dtype *array, int array_len, Dtype x,
+        int n_threads, const string ofilename)
+{
+    //The pairs file is truncated even if there are no pairs
+    ofstream ofp;
+    mutex lock;
+    if(!ofilename.empty())
+    {
+        ofp.open(ofilename, ios::binary);
+        if(!ofp.is_open())
+        {
+            cout << "Unable to open the pairs file\n";
+            return -1;
+        }
+    }
+    if(array_len < 2) return 0;
+
+    int *pos = new int[array_len];
+    int *buf = new int[array_len];
+    for(int i = 0; i < array_len; ++i) pos[i] = i;
+    merge_sort_positions(array, pos, buf, 0, array_len);
+    delete[] buf;
+
+    //End of the left half
+    int half = 0, end = array_len;
+    while(half < end)
+    {
+        int mid = half + (end - half) / 2;
+        if(2 * (long long)array[pos[mid]] <= x) half = mid + 1;
+        else end = mid;
+    }
+
+    //Segment boundaries, moved forward to the start of a run
+    int *bounds = new int[n_threads + 1];
+    for(int t = 0; t <= n_threads; ++t)
+    {
+        int b = int((long long)half * t / n_threads);
+        while(b > 0 && b < half && array[pos[b]] == array[pos[b - 1]]) ++b;
+        bounds[t] = b;
+    }
+
+    long long *counts = new long long[n_threads];
+    thread *threads = new thread[n_threads];
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t] = thread([&, t]()
+        {
+            PairWriter writer = {&ofp, &lock, nullptr, 0};
+            if(ofp.is_open())
+            {
+                writer.buf = new int[2 * PAIR_BUF_LEN];
+            }
+            counts[t] = all_pairs_segment(array, pos, array_len, x,
+                    bounds[t], bounds[t + 1],
+                    ofp.is_open() ? &writer : nullptr);
+            if(ofp.is_open())
+            {
+                pair_writer_flush(writer);
+                delete[] writer.buf;
+            }
+        });
+    }
+    long long count = 0;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+        count += counts[t];
+    }
+    delete[] threads;
+    delete[] counts;
+    delete[] bounds;
+    delete[] pos;
+    return count;
+}
+
+
 // Function to read array from terminal
 bool read_array_term(Dtype **array, int &array_len)
 {
@@ -296,6 +1360,20 @@ void usage(char *exe_name)
         " terminal)\n";
     cout << "2. " << exe_name << " <input file> (Reads input array from"\
         " file)\n";
+    cout << "3. " << exe_name << " -i <input file> -q <targets file> -o"\
+        " <result file> -m <method> -t <threads>\n";
+    cout << "   Batch mode. Builds a structure once from the input array and"\
+        " checks every target in the targets file (same format as the input"\
+        " file). Method is 1 (sorted copy), 2 (hash set) or 3 (bitset,"\
+        " default). Results are written to the result file as binary records"\
+        " of three 32 bit integers (found, i, j), where i and j are 0-based"\
+        " positions of the pair in the input array (-1 if not found).\n";
+    cout << "4. " << exe_name << " -i <input file> -p <x> -o <pairs file> -t"\
+        " <threads>\n";
+    cout << "   All-pairs mode. Counts all the pairs of positions whose values"\
+        " add to x. If the pairs file is given, every pair is written to it"\
+        " as two 32 bit integers (i, j), i < j. Pairs are not in any"\
+        " particular order.\n";
 }
 
 
@@ -331,12 +1409,217 @@ bool parse_input(int argc, char **argv, Dtype **array, int &array_len, Dtype &x)
 }
 
 
+//Parse and get input for the batch mode
+bool parse_batch_input(int argc, char **argv, Dtype **array, int &array_len,
+        Dtype **targets, int &n_targets, string &ofilename,
+        BATCH_METHOD &method, int &n_threads)
+{
+    if(argc % 2 == 0)
+    {
+        usage(argv[0]);
+        return false;
+    }
+    ofilename = "";
+    method = BATCH_BITSET;
+    n_threads = thread::hardware_concurrency();
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-i")
+        {
+            if(!read_array_file(argv[i + 1], array, array_len))
+            {
+                return false;
+            }
+        }
+        else if(arg_opt == "-q")
+        {
+            if(!read_array_file(argv[i + 1], targets, n_targets))
+            {
+                return false;
+            }
+        }
+        else if(arg_opt == "-o")
+        {
+            ofilename = string(argv[i + 1]);
+        }
+        else if(arg_opt == "-m")
+        {
+            int m = atoi(argv[i + 1]);
+            if(m < 1 || m > 3)
+            {
+                cout << "Unknown method\n";
+                return false;
+            }
+            method = BATCH_METHOD(m);
+        }
+        else if(arg_opt == "-t")
+        {
+            n_threads = atoi(argv[i + 1]);
+        }
+        else
+        {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    if(n_threads < 1) n_threads = 1;
+    if(*array == nullptr || *targets == nullptr || ofilename.empty())
+    {
+        usage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+
+//Batch mode
+int run_batch(int argc, char **argv)
+{
+    int array_len = 0, n_targets = 0, n_threads;
+    Dtype *array = nullptr, *targets = nullptr;
+    string ofilename;
+    BATCH_METHOD method;
+    if(!parse_batch_input(argc, argv, &array, array_len, &targets, n_targets,
+                ofilename, method, n_threads))
+    {
+        delete[] array;
+        delete[] targets;
+        return 0;
+    }
+
+    //A bitset over a wide range would need too much memory
+    int min, max;
+    if(method == BATCH_BITSET && array_len > 0)
+    {
+        findrange(array, array_len, min, max);
+        if((long long)max - min + 1 > DENSE_RANGE_FACTOR * array_len)
+        {
+            cout << "Value range is too wide for a bitset. Using hash set.\n";
+            method = BATCH_HASH;
+        }
+    }
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    TwoSumIndex index;
+    if(!two_sum_index_build(array, array_len, method, index))
+    {
+        cout << "Out of memory\n";
+        two_sum_index_free(index);
+        delete[] array;
+        delete[] targets;
+        return 1;
+    }
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    PairRecord *records = new PairRecord[n_targets > 0 ? n_targets : 1];
+    two_sum_batch(index, targets, n_targets, records, n_threads);
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+    int n_found = 0;
+    for(int q = 0; q < n_targets; ++q)
+    {
+        n_found += records[q].found;
+    }
+    cout << "Built the structure in " <<
+        chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "Checked " << n_targets << " targets in " <<
+        chrono::duration<double, milli>(t2 - t1).count() << " ms using " <<
+        n_threads << " thread(s). " << n_found << " can be factored.\n";
+    write_records_file(ofilename, records, n_targets);
+
+    two_sum_index_free(index);
+    delete[] records;
+    delete[] array;
+    delete[] targets;
+    return 0;
+}
+
+
+//All-pairs mode
+int run_all_pairs(int argc, char **argv)
+{
+    if(argc % 2 == 0)
+    {
+        usage(argv[0]);
+        return 0;
+    }
+    int array_len = 0;
+    Dtype *array = nullptr;
+    Dtype x = 0;
+    string ofilename = "";
+    int n_threads = thread::hardware_concurrency();
+    bool input_given = false;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-i")
+        {
+            if(!read_array_file(argv[i + 1], &array, array_len))
+            {
+                return 0;
+            }
+            input_given = true;
+        }
+        else if(arg_opt == "-p")
+        {
+            x = atoi(argv[i + 1]);
+        }
+        else if(arg_opt == "-o")
+        {
+            ofilename = string(argv[i + 1]);
+        }
+        else if(arg_opt == "-t")
+        {
+            n_threads = atoi(argv[i + 1]);
+        }
+        else
+        {
+            usage(argv[0]);
+            delete[] array;
+            return 0;
+        }
+    }
+    if(!input_given)
+    {
+        usage(argv[0]);
+        return 0;
+    }
+    if(n_threads < 1) n_threads = 1;
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    long long count = all_pairs(array, array_len, x, n_threads, ofilename);
+    chrono::duration<double, milli> time = chrono::steady_clock::now() - t0;
+    if(count >= 0)
+    {
+        cout << x << " can be written as sums of " << count << " pair(s)."
+            << endl;
+        cout << "Time taken is " << time.count() << " ms using " <<
+            n_threads << " thread(s)\n";
+    }
+    delete[] array;
+    return 0;
+}
+
+
 //Main
 int main(int argc, char **argv)
 {
     int array_len;
     Dtype *array = nullptr;
     Dtype x;
+
+    //Batch and all-pairs modes
+    if(argc > 2)
+    {
+        for(int i = 1; i < argc; i += 2)
+        {
+            if(string(argv[i]) == "-p")
+            {
+                return run_all_pairs(argc, argv);
+            }
+        }
+        return run_batch(argc, argv);
+    }
     
     //Parse arguments and read input array
     if(!parse_input(argc, argv, &array, array_len, x))
@@ -346,10 +1629,20 @@ int main(int argc, char **argv)
 
     //Call the algorithm
     cout << "There are 3 solutions. Enter a binary number to decide which all"\
-        " to use (0 - 7): ";
+        " to use (0 - 7), or 8 to select one automatically: ";
     unsigned int choice;
     cin >> choice;
 
+    if(choice == 8)
+    {
+        CostModel model;
+        get_cost_model(model);
+        cout << "\nAutomatic selection:\n";
+        solve_auto(array, array_len, x, model);
+        delete[] array;
+        return 0;
+    }
+
     clock_t t0;
     if(choice & (1 << 2))
     {
@@ -1,6 +1,30 @@
 /**
   Horner's rule to evaluate polynomial.
 
+  y = a_0 + x (a_1 + x (a_2 + ... + x (a_{n-1} + x a_n)))
+
+  Each step depends on the previous one, so evaluating at one point is a
+  chain of n dependent multiply-adds. When the polynomial is evaluated at
+  many points, the points are independent. The batch version keeps 8 points
+  in each SIMD register (AVX2) and works on 4 registers at a time, so that 4
+  independent FMA chains hide the latency of each other. The points are split
+  among threads.
+
+  For a single point and a high degree, the dependency chain itself is the
+  bottleneck. Three other evaluators expose instruction level parallelism:
+  - Second order Horner: the even and odd coefficients are two independent
+    Horner chains in x^2, P(x) = E(x^2) + x O(x^2).
+  - Estrin's scheme: adjacent pairs of coefficients are combined as
+    c_{2i} + c_{2i+1} x, then adjacent pairs of those as q_{2i} + q_{2i+1} x^2,
+    and so on with x^4, x^8, ... The dependency chain is only log n long and
+    all the operations of a level are independent.
+  - Parallel split: for very high degrees, the coefficients are split into
+    chunks which are evaluated by different threads. The chunk results are
+    combined with the powers of x at which the chunks start.
+  horners_rule_auto picks one of these by the degree.
+
+  Compile with -O2 -march=native -pthread to enable AVX2/FMA and threads.
+
 Author: Sandeep Palakkal
 Email: sandeep.dion@gmail.com
 Date: 18-Aug-2016
@@ -12,6 +36,11 @@ Date: 18-Aug-2016
 #include <ctime>
 #include <cstddef>
 #include <iomanip>
+#include <thread>
+#include <chrono>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -21,6 +50,15 @@ typedef float Dtype;
 //sort type
 enum SORT_TYPE {ASCEND, DESCEND};
 
+//Number of coefficients from which horners_rule_auto uses second order
+//Horner, Estrin's scheme and several threads (tuned on x86-64)
+const int HORNER2_MIN_LEN = 8;
+const int ESTRIN_MIN_LEN = 512;
+const int PARALLEL_MIN_LEN = 1 << 20;
+
+//Estrin's scheme works on the stack up to this many coefficients
+const int ESTRIN_STACK_LEN = 2048;
+
 
 Dtype horners_rule(Dtype *array, int array_len, Dtype x)
 {
@@ -33,6 +71,302 @@ Dtype horners_rule(Dtype *array, int array_len, Dtype x)
 }
 
 
+/**
+  Second order Horner's rule
+  */
+Dtype horners_rule2(const Dtype *array, int array_len, Dtype x)
+{
+    Dtype x2 = x * x;
+    Dtype even = 0, odd = 0;
+    int i = 0;
+    if(array_len % 2 == 1)
+    {
+        //Degree is even
+        even = array[0];
+        i = 1;
+    }
+    for(; i + 1 < array_len; i += 2)
+    {
+        odd = array[i] + x2 * odd;
+        even = array[i + 1] + x2 * even;
+    }
+    return even + x * odd;
+}
+
+
+/**
+  Estrin's scheme. scratch must have room for (array_len + 1) / 2 values.
+  */
+Dtype estrin(const Dtype *array, int array_len, Dtype x, Dtype *scratch)
+{
+    if(array_len <= 0) return 0;
+    //Coefficients are stored from the highest order. c_k = array[last - k].
+    const Dtype *c = array + array_len - 1;
+    int m = array_len / 2;
+    for(int i = 0; i < m; ++i)
+    {
+        scratch[i] = c[-2 * i] + c[-2 * i - 1] * x;
+    }
+    if(array_len % 2 == 1)
+    {
+        scratch[m++] = array[0];
+    }
+    Dtype p = x * x;
+    while(m > 1)
+    {
+        int half = m / 2;
+        for(int i = 0; i < half; ++i)
+        {
+            scratch[i] = scratch[2 * i] + scratch[2 * i + 1] * p;
+        }
+        if(m % 2 == 1)
+        {
+            scratch[half++] = scratch[m - 1];
+        }
+        m = half;
+        p = p * p;
+    }
+    return scratch[0];
+}
+
+
+/**
+  Estrin's scheme boilerplate
+  */
+Dtype estrin(const Dtype *array, int array_len, Dtype x)
+{
+    if(array_len <= 2 * ESTRIN_STACK_LEN)
+    {
+        Dtype scratch[ESTRIN_STACK_LEN];
+        return estrin(array, array_len, x, scratch);
+    }
+    Dtype *scratch = new Dtype[(array_len + 1) / 2];
+    Dtype y = estrin(array, array_len, x, scratch);
+    delete[] scratch;
+    return y;
+}
+
+
+/**
+  x^n by repeated squaring
+  */
+Dtype power(Dtype x, int n)
+{
+    Dtype y = 1;
+    while(n > 0)
+    {
+        if(n & 1) y *= x;
+        x *= x;
+        n >>= 1;
+    }
+    return y;
+}
+
+
+/**
+  Evaluate with n_threads threads. Thread t evaluates the chunk
+  array[beg .. end - 1] by Estrin's scheme, which is the polynomial
+  P_t(x) = sum of the chunk coefficients times x^(end - 1 - i). Its terms
+  belong to P(x) after multiplying by x^(array_len - end).
+  */
+Dtype horners_rule_parallel(const Dtype *array, int array_len, Dtype x,
+        int n_threads)
+{
+    if(n_threads <= 1)
+    {
+        return estrin(array, array_len, x);
+    }
+    Dtype *partial = new Dtype[n_threads];
+    thread *threads = new thread[n_threads];
+    int chunk = (array_len + n_threads - 1) / n_threads;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        int beg = (t * chunk < array_len) ? t * chunk : array_len;
+        int end = (beg + chunk < array_len) ? beg + chunk : array_len;
+        threads[t] = thread([=]()
+        {
+            partial[t] = estrin(array + beg, end - beg, x) *
+                power(x, array_len - end);
+        });
+    }
+    Dtype y = 0;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+        y += partial[t];
+    }
+    delete[] threads;
+    delete[] partial;
+    return y;
+}
+
+
+/**
+  Evaluate with the method suited to the degree
+  */
+Dtype horners_rule_auto(const Dtype *array, int array_len, Dtype x)
+{
+    if(array_len < HORNER2_MIN_LEN)
+    {
+        return horners_rule(const_cast<Dtype *>(array), array_len, x);
+    }
+    if(array_len < ESTRIN_MIN_LEN)
+    {
+        return horners_rule2(array, array_len, x);
+    }
+    if(array_len < PARALLEL_MIN_LEN)
+    {
+        return estrin(array, array_len, x);
+    }
+    return horners_rule_parallel(array, array_len, x,
+            thread::hardware_concurrency());
+}
+
+
+/**
+  Latency of one evaluation (ns) by each method. Each evaluation depends on
+  the previous one (x is updated with 0 * y), so that evaluations do not
+  overlap.
+  */
+void benchmark_latency(const Dtype *array, int array_len, Dtype x)
+{
+    const char *names[] = {"Horner", "Second order Horner", "Estrin",
+        "Automatic"};
+    int n_rep = int(1e8 / (array_len + 16));
+    if(n_rep < 1) n_rep = 1;
+    if(n_rep > 1000000) n_rep = 1000000;
+    for(int method = 0; method < 4; ++method)
+    {
+        Dtype xi = x, y = 0;
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        for(int r = 0; r < n_rep; ++r)
+        {
+            switch(method)
+            {
+                case 0:
+                    y = horners_rule(const_cast<Dtype *>(array), array_len,
+                            xi);
+                    break;
+                case 1:
+                    y = horners_rule2(array, array_len, xi);
+                    break;
+                case 2:
+                    y = estrin(array, array_len, xi);
+                    break;
+                default:
+                    y = horners_rule_auto(array, array_len, xi);
+                    break;
+            }
+            xi = x + 0 * y;
+        }
+        chrono::duration<double> time = chrono::steady_clock::now() - t0;
+        cout << names[method] << ": " << time.count() / n_rep * 1e9 <<
+            " ns per evaluation, P(x) = " << y << endl;
+    }
+}
+
+
+/**
+  Horner's rule at the points xs[beg .. end - 1]. Results are written to ys.
+  */
+void horners_rule_points(const Dtype *array, int array_len, const Dtype *xs,
+        Dtype *ys, int beg, int end)
+{
+    int i = beg;
+#if defined(__AVX2__) && defined(__FMA__)
+    //4 registers of 8 points
+    for(; i + 32 <= end; i += 32)
+    {
+        __m256 x0 = _mm256_loadu_ps(xs + i);
+        __m256 x1 = _mm256_loadu_ps(xs + i + 8);
+        __m256 x2 = _mm256_loadu_ps(xs + i + 16);
+        __m256 x3 = _mm256_loadu_ps(xs + i + 24);
+        __m256 y0 = _mm256_setzero_ps(), y1 = y0, y2 = y0, y3 = y0;
+        for(int k = 0; k < array_len; ++k)
+        {
+            __m256 a = _mm256_set1_ps(array[k]);
+            y0 = _mm256_fmadd_ps(x0, y0, a);
+            y1 = _mm256_fmadd_ps(x1, y1, a);
+            y2 = _mm256_fmadd_ps(x2, y2, a);
+            y3 = _mm256_fmadd_ps(x3, y3, a);
+        }
+        _mm256_storeu_ps(ys + i, y0);
+        _mm256_storeu_ps(ys + i + 8, y1);
+        _mm256_storeu_ps(ys + i + 16, y2);
+        _mm256_storeu_ps(ys + i + 24, y3);
+    }
+    for(; i + 8 <= end; i += 8)
+    {
+        __m256 x0 = _mm256_loadu_ps(xs + i);
+        __m256 y0 = _mm256_setzero_ps();
+        for(int k = 0; k < array_len; ++k)
+        {
+            y0 = _mm256_fmadd_ps(x0, y0, _mm256_set1_ps(array[k]));
+        }
+        _mm256_storeu_ps(ys + i, y0);
+    }
+#elif defined(__SSE2__)
+    //4 registers of 4 points
+    for(; i + 16 <= end; i += 16)
+    {
+        __m128 x0 = _mm_loadu_ps(xs + i);
+        __m128 x1 = _mm_loadu_ps(xs + i + 4);
+        __m128 x2 = _mm_loadu_ps(xs + i + 8);
+        __m128 x3 = _mm_loadu_ps(xs + i + 12);
+        __m128 y0 = _mm_setzero_ps(), y1 = y0, y2 = y0, y3 = y0;
+        for(int k = 0; k < array_len; ++k)
+        {
+            __m128 a = _mm_set1_ps(array[k]);
+            y0 = _mm_add_ps(_mm_mul_ps(x0, y0), a);
+            y1 = _mm_add_ps(_mm_mul_ps(x1, y1), a);
+            y2 = _mm_add_ps(_mm_mul_ps(x2, y2), a);
+            y3 = _mm_add_ps(_mm_mul_ps(x3, y3), a);
+        }
+        _mm_storeu_ps(ys + i, y0);
+        _mm_storeu_ps(ys + i + 4, y1);
+        _mm_storeu_ps(ys + i + 8, y2);
+        _mm_storeu_ps(ys + i + 12, y3);
+    }
+#endif
+    for(; i < end; ++i)
+    {
+        ys[i] = horners_rule(const_cast<Dtype *>(array), array_len, xs[i]);
+    }
+}
+
+
+/**
+  Horner's rule at n_points points using n_threads threads. Each thread
+  evaluates a contiguous range of points.
+  */
+void horners_rule_batch(const Dtype *array, int array_len, const Dtype *xs,
+        Dtype *ys, int n_points, int n_threads)
+{
+    if(n_threads <= 1 || n_points < 1024)
+    {
+        horners_rule_points(array, array_len, xs, ys, 0, n_points);
+        return;
+    }
+    thread *threads = new thread[n_threads];
+    //Chunks are multiples of 32 points, so that only the last one has a tail
+    int chunk = ((n_points + n_threads - 1) / n_threads + 31) / 32 * 32;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        int beg = (t * chunk < n_points) ? t * chunk : n_points;
+        int end = (beg + chunk < n_points) ? beg + chunk : n_points;
+        threads[t] = thread([=]()
+        {
+            horners_rule_points(array, array_len, xs, ys, beg, end);
+        });
+    }
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+    }
+    delete[] threads;
+}
+
+
 /**
   Read input array from terminal
   */
@@ -86,6 +420,12 @@ void usage(char *exe_file)
         " input_file. Coefficients must be saved from higher order to"\
         " lower order (a_n, ..., a_0). The first element should be the number"\
         " of elements in the file" << endl;
+    cout << "3. " << exe_file << " <input_file> <points_file> [<output_file>]"\
+        " (Evaluates the polynomial at every point in points_file, which has"\
+        " the same format as input_file. Values are written to output_file or"\
+        " to the terminal.)" << endl;
+    cout << "4. " << exe_file << " <input_file> -l (Reads the point and"\
+        " reports the latency per evaluation of each method.)" << endl;
 }
 
 int main(int argc, char **argv)
@@ -101,7 +441,7 @@ int main(int argc, char **argv)
     }
 
     Dtype *array = nullptr;
-    int array_len;
+    int array_len = 0;
     SORT_TYPE sort_type;
 
     if(argc == 1)
@@ -118,14 +458,65 @@ int main(int argc, char **argv)
         }
     }
     
+    //Evaluate at all the points in a file
+    if(argc > 2 && string(argv[2]) != "-l")
+    {
+        Dtype *xs = nullptr;
+        int n_points = 0;
+        if(!read_array(argv[2], &xs, n_points, sort_type))
+        {
+            cout << "Error in reading the points file" << endl;
+            if(array != nullptr) delete[] array;
+            return 0;
+        }
+        Dtype *ys = new Dtype[n_points > 0 ? n_points : 1];
+        int n_threads = thread::hardware_concurrency();
+        if(n_threads < 1) n_threads = 1;
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        horners_rule_batch(array, array_len, xs, ys, n_points, n_threads);
+        chrono::duration<double> time = chrono::steady_clock::now() - t0;
+        cout << "Horner's rule at " << n_points << " points took " <<
+            time.count() * 1000 << " ms (" << 2.0 * array_len * n_points /
+            time.count() * 1e-9 << " GFLOP/s) using " << n_threads <<
+            " thread(s)." << endl;
+        if(argc > 3)
+        {
+            ofstream out_file(argv[3]);
+            out_file << fixed;
+            for(int i = 0; i < n_points; ++i)
+            {
+                out_file << ys[i] << endl;
+            }
+        }
+        else
+        {
+            for(int i = 0; i < n_points; ++i)
+            {
+                cout << "P(" << xs[i] << ") = " << ys[i] << endl;
+            }
+        }
+        delete[] xs;
+        delete[] ys;
+        if(array != nullptr) delete[] array;
+        return 0;
+    }
+
     //Get point at which polynomial has to be evaluated
     Dtype x;
     cout << "Enter value at which polynomial to be evaluated: ";
     cin >> x;
  
+    //Latency benchmark
+    if(argc > 2)
+    {
+        benchmark_latency(array, array_len, x);
+        if(array != nullptr) delete[] array;
+        return 0;
+    }
+ 
     //Call Horner's rule
     clock_t time = clock();
-    Dtype y = horners_rule(array, array_len, x);
+    Dtype y = horners_rule_auto(array, array_len, x);
     time = clock() - time;
     cout << "Horner's rule took "<< 
         float(time) / CLOCKS_PER_SEC * 1000 << " ms." << endl;
@@ -0,0 +1,584 @@
+/**
+  Learned index over a sorted array (PGM-style piecewise linear model).
+
+  A sorted array is a monotone function from keys to positions. If the keys
+  are smooth (e.g., uniformly distributed), this function is well
+  approximated by a few straight lines. The array is split into segments and
+  each segment stores a line pos = intercept + slope * (key - first_key) such
+  that the predicted position of every key in the segment is within eps of its
+  true position. A lookup predicts the position and then runs a binary search
+  only in the window [pos - eps, pos + eps], which touches a couple of cache
+  lines instead of log2 n of them.
+
+  The segments are built in one pass by the shrinking cone method: starting
+  from the first key of a segment, keep the range of slopes [slope_lo,
+  slope_hi] which keeps every key seen so far within eps. Each new key narrows
+  this cone. When the cone becomes empty, a new segment starts at that key.
+
+  The first keys of the segments form another sorted array. So, the same
+  construction is applied on them recursively (with a small error bound
+  eps_rec) until a level has only a few segments. Lookup starts from the top
+  level and walks down, doing a bounded search at every level.
+
+  Index size is controlled by eps: a larger eps gives fewer segments but a
+  longer last-mile search.
+
+  Complexity: build n, lookup log(eps) per level.
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <ctime>
+#include <iomanip>
+
+using namespace std;
+
+typedef float Dtype;
+
+//Number of segments at the top level, below which no more levels are built
+const int TOP_LEVEL_SIZE = 16;
+
+
+/**
+  A linear segment of the model
+  */
+struct Segment
+{
+    Dtype key;        //first key covered by the segment
+    double slope;
+    double intercept; //position of key
+};
+
+
+/**
+  Learned index. levels[0] models the data array, levels[l] models the first
+  keys of levels[l - 1].
+  */
+struct LearnedIndex
+{
+    const Dtype *array;
+    int array_len;
+    int eps;
+    int eps_rec;
+    int n_levels;
+    Segment **levels;
+    int *level_len;
+};
+
+
+/**
+  Binary search
+  */
+int binary_search(const Dtype *array, int beg, int end, Dtype value)
+{
+    if(end == beg) return -1;
+    if(end - beg == 1)
+    {
+        return (array[beg] == value) ? beg : -1;
+    }
+    int mid = (beg + end) / 2;
+    if(array[mid] == value)
+    {
+        return mid;
+    }
+    if(array[mid] > value)
+    {
+        return binary_search(array, beg, mid, value);
+    }
+    else
+    {
+        return binary_search(array, mid, end, value);
+    }
+}
+
+
+/**
+  Boilerplate function for binary search
+  */
+int binary_search(const Dtype *array, int array_len, Dtype value)
+{
+    return binary_search(array, 0, array_len, value);
+}
+
+
+/**
+  Returns the first index in [beg, end) whose key is not less than value
+  */
+int lower_bound(const Dtype *array, int beg, int end, Dtype value)
+{
+    while(beg < end)
+    {
+        int mid = beg + (end - beg) / 2;
+        if(array[mid] < value) beg = mid + 1;
+        else end = mid;
+    }
+    return beg;
+}
+
+
+/**
+  Fit segments over keys (sorted, ascending) with the shrinking cone method.
+  Repeated keys are modelled by the position of their first occurrence.
+  segments must have room for key_len entries. Returns the number of segments.
+  */
+int build_segments(const Dtype *keys, int key_len, int eps, Segment *segments)
+{
+    int n_seg = 0;
+    if(key_len <= 0) return 0;
+
+    double x0 = keys[0], y0 = 0;
+    double slope_lo = 0, slope_hi = 1e300;
+    segments[0].key = keys[0];
+    segments[0].intercept = 0;
+    for(int i = 1; i < key_len; ++i)
+    {
+        if(keys[i] == keys[i - 1]) continue;
+        double dx = double(keys[i]) - x0;
+        double y = i;
+        //Check if the key lies in the current cone
+        if(slope_lo * dx > y + eps - y0 || slope_hi * dx < y - eps - y0)
+        {
+            //Close the current segment and open a new one at this key
+            segments[n_seg].slope = (slope_hi == 1e300) ? slope_lo :
+                (slope_lo + slope_hi) / 2;
+            ++n_seg;
+            x0 = keys[i];
+            y0 = y;
+            slope_lo = 0;
+            slope_hi = 1e300;
+            segments[n_seg].key = keys[i];
+            segments[n_seg].intercept = y;
+            continue;
+        }
+        //Shrink the cone
+        double lo = (y - eps - y0) / dx;
+        double hi = (y + eps - y0) / dx;
+        if(lo > slope_lo) slope_lo = lo;
+        if(hi < slope_hi) slope_hi = hi;
+    }
+    segments[n_seg].slope = (slope_hi == 1e300) ? slope_lo :
+        (slope_lo + slope_hi) / 2;
+    return n_seg + 1;
+}
+
+
+/**
+  Predict the position of value using segment seg. last is the position of
+  the last key covered by the segment. The line may overshoot for values past
+  the last key, so the prediction is clipped to it.
+  */
+inline int predict(const Segment &seg, Dtype value, int last)
+{
+    double pos = seg.intercept + seg.slope * (double(value) - seg.key);
+    if(pos < 0) return 0;
+    return pos > last ? last : int(pos);
+}
+
+
+/**
+  Position of the last key covered by segment seg of a level
+  */
+inline int last_position(const Segment *segments, int n_seg, int seg,
+        int key_len)
+{
+    return (seg + 1 < n_seg) ? int(segments[seg + 1].intercept) - 1 :
+        key_len - 1;
+}
+
+
+/**
+  Free the memory held by the index
+  */
+void free_learned_index(LearnedIndex &index)
+{
+    for(int l = 0; l < index.n_levels; ++l)
+    {
+        delete[] index.levels[l];
+    }
+    delete[] index.levels;
+    delete[] index.level_len;
+    index.levels = nullptr;
+    index.level_len = nullptr;
+    index.n_levels = 0;
+}
+
+
+/**
+  Build the learned index on a sorted (ascending) array
+  */
+void build_learned_index(const Dtype *array, int array_len, int eps,
+        int eps_rec, LearnedIndex &index)
+{
+    index.array = array;
+    index.array_len = array_len;
+    index.eps = eps;
+    index.eps_rec = eps_rec;
+
+    //At most 32 levels are ever needed
+    index.levels = new Segment*[32];
+    index.level_len = new int[32];
+    index.n_levels = 0;
+
+    const Dtype *keys = array;
+    int key_len = array_len;
+    Dtype *level_keys = nullptr;
+    int level_eps = eps;
+    while(key_len > 0)
+    {
+        Segment *buf = new Segment[key_len];
+        int n_seg = build_segments(keys, key_len, level_eps, buf);
+
+        //Shrink the buffer to the size used
+        Segment *segments = new Segment[n_seg];
+        for(int i = 0; i < n_seg; ++i) segments[i] = buf[i];
+        delete[] buf;
+        index.levels[index.n_levels] = segments;
+        index.level_len[index.n_levels] = n_seg;
+        ++index.n_levels;
+        if(n_seg <= TOP_LEVEL_SIZE || n_seg == key_len || index.n_levels == 32)
+        {
+            break;
+        }
+
+        //The first keys of the segments are the keys of the next level
+        delete[] level_keys;
+        level_keys = new Dtype[n_seg];
+        for(int i = 0; i < n_seg; ++i) level_keys[i] = segments[i].key;
+        keys = level_keys;
+        key_len = n_seg;
+        level_eps = eps_rec;
+    }
+    delete[] level_keys;
+}
+
+
+/**
+  Returns the last segment in [beg, end) whose first key is not greater than
+  value. Returns beg if there is none.
+  */
+int find_segment(const Segment *segments, int beg, int end, Dtype value)
+{
+    while(end - beg > 1)
+    {
+        int mid = beg + (end - beg) / 2;
+        if(segments[mid].key <= value) beg = mid;
+        else end = mid;
+    }
+    return beg;
+}
+
+
+/**
+  Search for value using the learned index. Returns its position in the array
+  or -1 if it is not found.
+  */
+int learned_index_search(const LearnedIndex &index, Dtype value)
+{
+    if(index.n_levels == 0) return -1;
+
+    //Top level is small. Search it in full.
+    int l = index.n_levels - 1;
+    int seg = find_segment(index.levels[l], 0, index.level_len[l], value);
+
+    //Walk down the levels
+    for(; l > 0; --l)
+    {
+        const Segment *below = index.levels[l - 1];
+        int below_len = index.level_len[l - 1];
+        int last = last_position(index.levels[l], index.level_len[l], seg,
+                below_len);
+        int pos = predict(index.levels[l][seg], value, last);
+        int beg = pos - index.eps_rec - 1;
+        int end = pos + index.eps_rec + 2;
+        if(beg < 0) beg = 0;
+        if(end > below_len) end = below_len;
+        if(beg >= end) beg = end - 1;
+        seg = find_segment(below, beg, end, value);
+    }
+
+    //Last mile search in the data array
+    int last = last_position(index.levels[0], index.level_len[0], seg,
+            index.array_len);
+    int pos = predict(index.levels[0][seg], value, last);
+    int beg = pos - index.eps - 1;
+    int end = pos + index.eps + 2;
+    if(beg < 0) beg = 0;
+    if(end > index.array_len) end = index.array_len;
+    if(beg >= end) return -1;
+    int i = lower_bound(index.array, beg, end, value);
+    return (i < end && index.array[i] == value) ? i : -1;
+}
+
+
+/**
+  Size of the index in bytes (excluding the data array)
+  */
+size_t learned_index_size(const LearnedIndex &index)
+{
+    size_t n_seg = 0;
+    for(int l = 0; l < index.n_levels; ++l)
+    {
+        n_seg += index.level_len[l];
+    }
+    return n_seg * sizeof(Segment);
+}
+
+
+/**
+  Read array from terminal
+  */
+bool read_array_term(Dtype **array, int &array_len)
+{
+    cout << "Enter the length of the array: ";
+    cin >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    cout << "Enter the array elements (sorted in ascending order): ";
+    for(int i = 0; i < array_len; ++i)
+    {
+        cin >> (*array)[i];
+    }
+   return true;
+}
+
+
+/**
+  Read array from file
+  */
+bool read_array_file(const string filename, Dtype **array, int &array_len)
+{
+    ifstream fp {filename};
+    cout << "Reading input file... ";
+    if(!fp.is_open())
+    {
+        cout << "Error: Input file could not be opened\n";
+        return false;
+    }
+    fp >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    for(int i = 0; i < array_len; ++i)
+    {
+        fp >> (*array)[i];
+    }
+    fp.close();
+    cout << "Read " << array_len << " elements." << endl;
+    return true;
+}
+
+
+/**
+  Compare learned index with binary search on n_queries random lookups. Half
+  of the queries are keys present in the array.
+  */
+void benchmark(const Dtype *array, int array_len, const LearnedIndex &index,
+        int n_queries)
+{
+    if(array_len == 0 || n_queries <= 0) return;
+    Dtype *queries = new Dtype[n_queries];
+    Dtype lo = array[0], hi = array[array_len - 1];
+    for(int i = 0; i < n_queries; ++i)
+    {
+        if(i % 2 == 0)
+        {
+            queries[i] = array[rand() % array_len];
+        }
+        else
+        {
+            queries[i] = lo + (hi - lo) * (rand() / float(RAND_MAX));
+        }
+    }
+
+    //Binary search
+    long long check1 = 0;
+    clock_t t0 = clock();
+    for(int i = 0; i < n_queries; ++i)
+    {
+        check1 += binary_search(array, array_len, queries[i]) != -1;
+    }
+    t0 = clock() - t0;
+    cout << "Binary search: " << float(t0) / CLOCKS_PER_SEC * 1e9 / n_queries
+        << " ns per lookup." << endl;
+
+    //Learned index
+    long long check2 = 0;
+    int n_wrong = 0;
+    clock_t t1 = clock();
+    for(int i = 0; i < n_queries; ++i)
+    {
+        check2 += learned_index_search(index, queries[i]) != -1;
+    }
+    t1 = clock() - t1;
+    cout << "Learned index: " << float(t1) / CLOCKS_PER_SEC * 1e9 / n_queries
+        << " ns per lookup." << endl;
+
+    //Verify
+    for(int i = 0; i < n_queries; ++i)
+    {
+        int pos = learned_index_search(index, queries[i]);
+        bool found = binary_search(array, array_len, queries[i]) != -1;
+        if((pos != -1) != found || (pos != -1 && array[pos] != queries[i]))
+        {
+            ++n_wrong;
+        }
+    }
+    cout << "Found " << check1 << " (binary search) and " << check2 <<
+        " (learned index) of " << n_queries << " queries. Mismatches: " <<
+        n_wrong << endl;
+    delete[] queries;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Learned index search. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -i <input file> -e <eps> -r <eps_rec> -n"\
+        " <number of benchmark queries>" << endl;
+    cout << "   Reads input array from input file. First element in the file"\
+        " must be the length of the array. The array must be sorted in"\
+        " ascending order.\n";
+    cout << "   eps is the maximum position error of the model at the data"\
+        " level (default 64). eps_rec is the same for the upper levels"\
+        " (default 4). Larger values give a smaller index.\n";
+    cout << "   If the number of queries is given, learned index is compared"\
+        " against binary search.\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
+        int &array_len, int &eps, int &eps_rec, int &n_queries)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    *array = nullptr;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input")
+        {
+            if(!read_array_file(string(argv[i + 1]), array, array_len))
+            {
+                return false;
+            }
+        }
+        if(arg_opt == "-e" || arg_opt == "--eps")
+        {
+            eps = atoi(argv[i + 1]);
+        }
+        if(arg_opt == "-r" || arg_opt == "--eps_rec")
+        {
+            eps_rec = atoi(argv[i + 1]);
+        }
+        if(arg_opt == "-n" || arg_opt == "--queries")
+        {
+            n_queries = atoi(argv[i + 1]);
+        }
+    }
+    if(eps < 1 || eps_rec < 1)
+    {
+        cout << "Error: eps and eps_rec must be positive\n";
+        return false;
+    }
+    if(*array == nullptr)
+    {
+        if(!read_array_term(array, array_len))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Dtype *array = nullptr;
+    int array_len = 0;
+    int eps = 64, eps_rec = 4, n_queries = 0;
+
+    //Parse and get inputs
+    if(!parse_and_get_inputs(argc, argv, &array, array_len, eps, eps_rec,
+                n_queries))
+    {
+        return 0;
+    }
+
+    //The model needs a sorted array
+    for(int i = 1; i < array_len; ++i)
+    {
+        if(array[i] < array[i - 1])
+        {
+            cout << "Error: Input array is not sorted in ascending order\n";
+            delete[] array;
+            return 0;
+        }
+    }
+
+    //Build the index
+    LearnedIndex index;
+    clock_t t0 = clock();
+    build_learned_index(array, array_len, eps, eps_rec, index);
+    t0 = clock() - t0;
+    cout << "Time taken to build the index: "
+        << float(t0)/CLOCKS_PER_SEC * 1000 << " ms.\n";
+    cout << "Index has " << index.n_levels << " level(s) with";
+    for(int l = 0; l < index.n_levels; ++l)
+    {
+        cout << " " << index.level_len[l];
+    }
+    cout << " segment(s). Size: " << learned_index_size(index) << " bytes.\n";
+
+    if(n_queries > 0)
+    {
+        benchmark(array, array_len, index, n_queries);
+    }
+    else
+    {
+        //Read the element to be searched
+        Dtype value;
+        cout << "Enter the value to be searched for: ";
+        cin >> value;
+        int pos = learned_index_search(index, value);
+        if(pos != -1)
+        {
+            cout << "Searched value appears at: " << pos + 1 << endl;
+            cout << "Array[" << pos << "] = " << setprecision(6) << fixed
+                << array[pos] << endl;
+        }
+        else
+        {
+            cout << "The searched value does not exist in the array\n";
+        }
+    }
+
+    //Free memory
+    free_learned_index(index);
+    if(array != nullptr)
+    {
+        delete[] array;
+    }
+
+    return 0;
+}
@@ -0,0 +1,609 @@
+/**
+  k-sum: check if k numbers at different positions in an array add to x, or
+  count the number of such k-subsets of positions. This generalizes the two
+  sum problem of excercise 2.3-7.
+
+  k = 2, 3: The array is sorted once with merge sort. For 3-sum, the smallest
+  element a[i] of the triple is fixed and the remaining two are found by the
+  two pointer sweep of excercise 2.3-7 over a[i + 1 .. n - 1] for x - a[i].
+  The n sweeps are independent, so they are shared by several threads, which
+  take a few values of i at a time. Runs of equal values are counted with
+  multiplicity.
+  Complexity: n^2 (3-sum), n log n (2-sum)
+
+  k >= 4: Meet in the middle. A k-subset i_1 < ... < i_k is split into the
+  left part (first k / 2 positions) and the right part (the rest). For every
+  m from n - 1 down, the sums of the right parts whose smallest position is
+  m + 1 are added to a hash table of sums. Then the sums of the left parts
+  whose largest position is m are looked up for their complements. Every
+  k-subset is seen exactly once. In find mode, the table also keeps the
+  positions of one right part for every sum, so that the k-subset found can
+  be printed.
+  Complexity: n^ceil(k / 2) time and memory
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+using namespace std;
+
+typedef int Dtype;
+
+//Search modes
+enum SEARCH_MODE {FIND, COUNT};
+
+//Number of sweeps taken by a thread at a time
+const int SWEEP_CHUNK = 16;
+
+
+/**
+  Part of merge sort algorithm. Merges to arrays according the the sorting
+  order.*/
+void merge(Dtype *array1, Dtype *array2, int beg, int mid, int end)
+{
+    int i = beg, j = mid, k = beg;
+    while(k < end)
+    {
+        if(array1[i] > array1[j])
+        {
+            array2[k++] = array1[j++];
+        }
+        else
+        {
+            array2[k++] = array1[i++];
+        }
+        if(i == mid || j == end)
+        {
+            break;
+        }
+    }
+    while(i < mid)
+    {
+        array2[k++] = array1[i++];
+    }
+    while(j < end)
+    {
+        array2[k++] = array1[j++];
+    }
+    for(i = beg; i < end; ++i)
+    {
+        array1[i] = array2[i];
+    }
+}
+
+/**
+  Merge sort algorithm recursive implementation
+  */
+void merge_sort(Dtype *array1, Dtype *array2, int beg, int end)
+{
+    if(end - beg <= 1)
+    {
+        return;
+    }
+    int mid = (beg + end) / 2;
+    merge_sort(array1, array2, beg, mid);
+    merge_sort(array1, array2, mid, end);
+    merge(array1, array2, beg, mid, end);
+}
+
+/**
+  Uses merge sort to sort array1 and the result is given in array2
+  */
+void merge_sort(Dtype *array1, Dtype *array2, int array_len)
+{
+    for(int i = 0; i < array_len; ++i)
+    {
+        array2[i] = array1[i];
+    }
+    Dtype *array3 = new Dtype [array_len];
+    merge_sort(array2, array3, 0, array_len);
+    delete[] array3;
+}
+
+
+/**
+  Two pointer sweep over the sorted array[lo .. hi] for pairs adding to t.
+  In FIND mode, returns 1 at the first pair and sets a and b. In COUNT mode,
+  returns the number of pairs of positions.
+  */
+long long two_sum_sweep(const Dtype *array, int lo, int hi, long long t,
+        SEARCH_MODE mode, Dtype &a, Dtype &b)
+{
+    long long count = 0;
+    while(lo < hi)
+    {
+        long long sum = (long long)array[lo] + array[hi];
+        if(sum < t) ++lo;
+        else if(sum > t) --hi;
+        else
+        {
+            if(mode == FIND)
+            {
+                a = array[lo];
+                b = array[hi];
+                return 1;
+            }
+            if(array[lo] == array[hi])
+            {
+                //All the values in between are the same
+                long long c = hi - lo + 1;
+                count += c * (c - 1) / 2;
+                break;
+            }
+            long long cl = 1, ch = 1;
+            while(array[lo + cl] == array[lo]) ++cl;
+            while(array[hi - ch] == array[hi]) ++ch;
+            count += cl * ch;
+            lo += cl;
+            hi -= ch;
+        }
+    }
+    return count;
+}
+
+
+/**
+  3-sum over the sorted array using n_threads threads. In FIND mode, the
+  first triple found by any thread stops all the threads and is returned in
+  triple. Returns the number of triples (at most 1 in FIND mode).
+  */
+long long three_sum(const Dtype *array, int array_len, long long x,
+        SEARCH_MODE mode, int n_threads, Dtype *triple)
+{
+    atomic<int> next(0);
+    atomic<bool> found(false);
+    mutex lock;
+    long long *counts = new long long[n_threads];
+    thread *threads = new thread[n_threads];
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t] = thread([&, t]()
+        {
+            long long count = 0;
+            int beg;
+            while((beg = next.fetch_add(SWEEP_CHUNK)) < array_len - 2)
+            {
+                int end = (beg + SWEEP_CHUNK < array_len - 2) ?
+                    beg + SWEEP_CHUNK : array_len - 2;
+                for(int i = beg; i < end; ++i)
+                {
+                    if(mode == FIND && found.load(memory_order_relaxed))
+                    {
+                        counts[t] = count;
+                        return;
+                    }
+                    Dtype a, b;
+                    long long c = two_sum_sweep(array, i + 1, array_len - 1,
+                            x - array[i], mode, a, b);
+                    if(mode == FIND && c > 0)
+                    {
+                        lock_guard<mutex> guard(lock);
+                        if(!found.load())
+                        {
+                            triple[0] = array[i];
+                            triple[1] = a;
+                            triple[2] = b;
+                            found = true;
+                        }
+                    }
+                    count += c;
+                }
+            }
+            counts[t] = count;
+        });
+    }
+    long long count = 0;
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+        count += counts[t];
+    }
+    delete[] threads;
+    delete[] counts;
+    return (mode == FIND) ? (found ? 1 : 0) : count;
+}
+
+
+/**
+  Hash table from sums to their counts (open addressing, linear probing).
+  Slot i also keeps width positions at witness[i * width], those of the
+  first subset added with the sum in it.
+  */
+struct SumCountMap
+{
+    long long *keys;
+    long long *counts;
+    bool *used;
+    int *witness;
+    int width;
+    long long capacity; //power of 2
+    long long size;
+};
+
+
+/**
+  Allocate an empty table with width witness positions per sum
+  */
+void sum_map_init(SumCountMap &map, long long capacity, int width)
+{
+    map.capacity = 16;
+    while(map.capacity < capacity) map.capacity *= 2;
+    map.keys = new long long[map.capacity];
+    map.counts = new long long[map.capacity];
+    map.used = new bool[map.capacity]{};
+    map.width = width;
+    map.witness = new int[map.capacity * width];
+    map.size = 0;
+}
+
+
+/**
+  Free the table
+  */
+void sum_map_free(SumCountMap &map)
+{
+    delete[] map.keys;
+    delete[] map.counts;
+    delete[] map.used;
+    delete[] map.witness;
+}
+
+
+/**
+  Slot of key: either the slot holding it or the empty slot to put it in
+  */
+inline long long sum_map_slot(const SumCountMap &map, long long key)
+{
+    unsigned long long h = (unsigned long long)key * 0x9E3779B97F4A7C15ULL;
+    long long i = (h ^ (h >> 32)) & (map.capacity - 1);
+    while(map.used[i] && map.keys[i] != key)
+    {
+        i = (i + 1) & (map.capacity - 1);
+    }
+    return i;
+}
+
+
+/**
+  Add one to the count of key. If key is new, positions[0 .. width - 1]
+  become its witness. The table is doubled when half full.
+  */
+void sum_map_add(SumCountMap &map, long long key, const int *positions)
+{
+    const int w = map.width;
+    if(2 * (map.size + 1) > map.capacity)
+    {
+        SumCountMap bigger;
+        sum_map_init(bigger, 2 * map.capacity, w);
+        for(long long i = 0; i < map.capacity; ++i)
+        {
+            if(!map.used[i]) continue;
+            long long j = sum_map_slot(bigger, map.keys[i]);
+            bigger.used[j] = true;
+            bigger.keys[j] = map.keys[i];
+            bigger.counts[j] = map.counts[i];
+            for(int p = 0; p < w; ++p)
+            {
+                bigger.witness[j * w + p] = map.witness[i * w + p];
+            }
+        }
+        bigger.size = map.size;
+        sum_map_free(map);
+        map = bigger;
+    }
+    long long i = sum_map_slot(map, key);
+    if(!map.used[i])
+    {
+        map.used[i] = true;
+        map.keys[i] = key;
+        map.counts[i] = 0;
+        for(int p = 0; p < w; ++p)
+        {
+            map.witness[i * w + p] = positions[p];
+        }
+        ++map.size;
+    }
+    ++map.counts[i];
+}
+
+
+/**
+  Slot holding key, or -1 if it is absent
+  */
+inline long long sum_map_find(const SumCountMap &map, long long key)
+{
+    long long i = sum_map_slot(map, key);
+    return map.used[i] ? i : -1;
+}
+
+
+/**
+  Call visit(sum) for the sum of every size-subset of positions in [beg, end)
+  added to partial. The positions of the subset are in positions[0 .. size -
+  1] during the call.
+  */
+template <typename Visitor>
+void visit_subsets(const Dtype *array, int beg, int end, int size,
+        long long partial, int *positions, Visitor &visit)
+{
+    if(size == 0)
+    {
+        visit(partial);
+        return;
+    }
+    for(int i = beg; i <= end - size; ++i)
+    {
+        positions[0] = i;
+        visit_subsets(array, i + 1, end, size - 1, partial + array[i],
+                positions + 1, visit);
+    }
+}
+
+
+/**
+  k-sum (k >= 4) by meet in the middle. Returns the number of k-subsets of
+  positions whose values add to x (at most 1 in FIND mode). In FIND mode,
+  the values of the k-subset found are written to tuple (of length k), in
+  the order of their positions.
+  */
+long long k_sum_mitm(const Dtype *array, int array_len, int k, long long x,
+        SEARCH_MODE mode, Dtype *tuple)
+{
+    int h = k / 2, r = k - h;
+    long long count = 0;
+    SumCountMap map;
+    sum_map_init(map, 1024, (mode == FIND) ? r : 0);
+    int *left = new int[h];
+    int *right = new int[r];
+    auto add_right = [&](long long sum) { sum_map_add(map, sum, right); };
+    auto find_left = [&](long long sum)
+    {
+        long long i = sum_map_find(map, x - sum);
+        if(i < 0) return;
+        if(mode == FIND && count == 0)
+        {
+            for(int p = 0; p < h; ++p) tuple[p] = array[left[p]];
+            for(int p = 0; p < r; ++p)
+            {
+                tuple[h + p] = array[map.witness[i * r + p]];
+            }
+        }
+        count += map.counts[i];
+    };
+    for(int m = array_len - r - 1; m >= h - 1; --m)
+    {
+        //Right parts starting at m + 1
+        right[0] = m + 1;
+        visit_subsets(array, m + 2, array_len, r - 1, array[m + 1],
+                right + 1, add_right);
+        //Left parts ending at m
+        left[h - 1] = m;
+        visit_subsets(array, 0, m, h - 1, array[m], left, find_left);
+        if(mode == FIND && count > 0)
+        {
+            count = 1;
+            break;
+        }
+    }
+    delete[] left;
+    delete[] right;
+    sum_map_free(map);
+    return count;
+}
+
+
+/**
+  Read array from terminal
+  */
+bool read_array_term(Dtype **array, int &array_len)
+{
+    cout << "Enter input array size: ";
+    cin >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    cout << "Enter input array elements: ";
+    for(int i = 0; i < array_len; ++i)
+    {
+        cin >> (*array)[i];
+    }
+    return true;
+}
+
+
+/**
+  Read array from file
+  */
+bool read_array_file(const string filename, Dtype **array, int &array_len)
+{
+    ifstream fp {filename};
+    if(!fp.is_open())
+    {
+        cout << "Unable to read from the given file\n";
+        return false;
+    }
+    fp >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    for(int i = 0; i < array_len; ++i)
+    {
+        fp >> (*array)[i];
+    }
+    return true;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "k-sum. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -i <input file> -k <k> -x <x> -m <mode> -t"\
+        " <threads>" << endl;
+    cout << "   Reads input array from input file. First element in the file"\
+        " must be the length of the array.\n";
+    cout << "   Mode is 1 (find one k-subset, default) or 2 (count all the"\
+        " k-subsets).\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
+        int &array_len, int &k, long long &x, SEARCH_MODE &mode,
+        int &n_threads)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    *array = nullptr;
+    k = 0;
+    bool x_given = false;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input")
+        {
+            if(!read_array_file(string(argv[i + 1]), array, array_len))
+            {
+                return false;
+            }
+        }
+        if(arg_opt == "-k")
+        {
+            k = atoi(argv[i + 1]);
+        }
+        if(arg_opt == "-x")
+        {
+            x = atoll(argv[i + 1]);
+            x_given = true;
+        }
+        if(arg_opt == "-m" || arg_opt == "--mode")
+        {
+            mode = (atoi(argv[i + 1]) == 2) ? COUNT : FIND;
+        }
+        if(arg_opt == "-t" || arg_opt == "--threads")
+        {
+            n_threads = atoi(argv[i + 1]);
+        }
+    }
+    if(*array == nullptr)
+    {
+        if(!read_array_term(array, array_len))
+        {
+            return false;
+        }
+    }
+    if(k == 0)
+    {
+        cout << "Enter k: ";
+        cin >> k;
+    }
+    if(!x_given)
+    {
+        cout << "Enter the number to factor: ";
+        cin >> x;
+    }
+    if(k < 2)
+    {
+        cout << "Error: k must be at least 2\n";
+        return false;
+    }
+    if(n_threads < 1) n_threads = 1;
+    return true;
+}
+
+
+int main(int argc, char **argv)
+{
+    Dtype *array = nullptr;
+    int array_len = 0, k;
+    long long x = 0;
+    SEARCH_MODE mode = FIND;
+    int n_threads = thread::hardware_concurrency();
+
+    //Parse and get inputs
+    if(!parse_and_get_inputs(argc, argv, &array, array_len, k, x, mode,
+                n_threads))
+    {
+        delete[] array;
+        return 0;
+    }
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    long long count = 0;
+    Dtype *tuple = new Dtype[k];
+    if(k > array_len)
+    {
+        count = 0;
+    }
+    else if(k <= 3)
+    {
+        //Sort once
+        Dtype *array_sort = new Dtype[array_len];
+        merge_sort(array, array_sort, array_len);
+        if(k == 2)
+        {
+            count = two_sum_sweep(array_sort, 0, array_len - 1, x, mode,
+                    tuple[0], tuple[1]);
+        }
+        else
+        {
+            count = three_sum(array_sort, array_len, x, mode, n_threads,
+                    tuple);
+        }
+        delete[] array_sort;
+    }
+    else
+    {
+        count = k_sum_mitm(array, array_len, k, x, mode, tuple);
+    }
+    chrono::duration<double, milli> time = chrono::steady_clock::now() - t0;
+
+    //Print result
+    if(mode == COUNT)
+    {
+        cout << x << " can be written as sums of " << k << " numbers in " <<
+            count << " way(s)." << endl;
+    }
+    else if(count > 0)
+    {
+        cout << x << " can be written as a sum of " << k << " numbers:";
+        for(int i = 0; i < k; ++i)
+        {
+            cout << (i > 0 ? " + " : " ") << tuple[i];
+        }
+        cout << endl;
+    }
+    else
+    {
+        cout << x << " cannot be written as sums of any " << k << " numbers"\
+            " in the given array." << endl;
+    }
+    cout << "Time taken is " << time.count() << " ms\n";
+
+    delete[] tuple;
+    delete[] array;
+    return 0;
+}
@@ -0,0 +1,686 @@
+/**
+  Fast multipoint evaluation of a polynomial using a subproduct tree.
+
+  Evaluating a polynomial of degree n at n points by Horner's rule takes n^2
+  operations. Since P(x_i) = P(x) mod (x - x_i), the values can be found by
+  taking remainders down a tree:
+  - Subproduct tree: the leaves are (x - x_i). Each node is the product of
+    its two children, so the root is the product of all (x - x_i).
+  - Remainder tree: the root gets P mod root. Each child gets the remainder
+    of its parent mod the child. At a leaf, the remainder is P(x_i).
+  Polynomial products use the number theoretic transform (NTT), and a
+  remainder is computed from the inverse of the reversed divisor by Newton
+  iteration. Both are O(n log n), so the whole evaluation is O(n log^2 n).
+
+  The tree stops at blocks of LEAF_POINTS points. There, the remainder (of
+  degree < LEAF_POINTS) is evaluated at the points of the block by Horner's
+  rule. The remainder at the root has degree < n whatever the number of
+  points, so more points than coefficients are split into blocks of about n
+  points with one tree each. If the polynomial or a block of points is
+  small, Horner's rule is used instead, on several points at a time.
+
+  Arithmetic is exact, modulo the prime p = 998244353 = 119 * 2^23 + 1. So,
+  coefficients, points and values are integers modulo p. (In floating point,
+  the remainders of the subproduct tree lose all precision well before
+  n = 1e6.) NTT lengths are limited to 2^23, so polynomials of more than
+  2^22 coefficients are split into pieces of 2^22, each evaluated with the
+  trees, and the values of the pieces are combined by Horner's rule in
+  x^(2^22).
+
+  Complexity: n log^2 n
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <ctime>
+
+using namespace std;
+
+typedef unsigned int Dtype;
+
+//Prime modulus and a primitive root of it
+const Dtype MOD = 998244353;
+const Dtype ROOT = 3;
+
+//Number of points in a leaf block of the tree
+const int LEAF_POINTS = 64;
+
+//Below this number of coefficients, Horner's rule is used. Against Horner's
+//rule on HORNER_LANES points at a time, the subproduct trees break even at
+//about 4096 to 5120 coefficients and win clearly from 6144.
+const int FAST_MIN_LEN = 6144;
+
+//Products with a factor shorter than this are done by schoolbook
+//multiplication
+const int SCHOOLBOOK_LEN = 32;
+
+//Longest NTT: MOD - 1 has the factor 2^23 only
+const int MAX_NTT_LEN = 1 << 23;
+
+//Longest polynomial for the subproduct trees. Their NTTs are at most twice
+//as long as the polynomial, so longer ones are split into pieces of this
+//many coefficients.
+const int FAST_MAX_LEN = MAX_NTT_LEN / 2;
+
+//Number of points taken together by Horner's rule
+const int HORNER_LANES = 8;
+
+
+/**
+  b^e mod MOD
+  */
+Dtype mod_pow(Dtype b, unsigned long long e)
+{
+    unsigned long long r = 1, base = b;
+    while(e > 0)
+    {
+        if(e & 1) r = r * base % MOD;
+        base = base * base % MOD;
+        e >>= 1;
+    }
+    return Dtype(r);
+}
+
+
+/**
+  In place NTT of a (length n, a power of 2 up to MAX_NTT_LEN). The inverse
+  transform includes the division by n.
+  */
+void ntt(Dtype *a, int n, bool invert)
+{
+    //Bit reversal permutation
+    for(int i = 1, j = 0; i < n; ++i)
+    {
+        int bit = n >> 1;
+        for(; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if(i < j)
+        {
+            Dtype t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+    Dtype *w = new Dtype[n / 2 > 0 ? n / 2 : 1];
+    for(int len = 2; len <= n; len <<= 1)
+    {
+        Dtype wlen = mod_pow(ROOT, (MOD - 1) / len);
+        if(invert) wlen = mod_pow(wlen, MOD - 2);
+        int half = len / 2;
+        w[0] = 1;
+        for(int k = 1; k < half; ++k)
+        {
+            w[k] = Dtype((unsigned long long)w[k - 1] * wlen % MOD);
+        }
+        for(int i = 0; i < n; i += len)
+        {
+            for(int k = 0; k < half; ++k)
+            {
+                Dtype u = a[i + k];
+                Dtype v = Dtype((unsigned long long)a[i + k + half] * w[k] %
+                        MOD);
+                a[i + k] = (u + v >= MOD) ? u + v - MOD : u + v;
+                a[i + k + half] = (u >= v) ? u - v : u + MOD - v;
+            }
+        }
+    }
+    delete[] w;
+    if(invert)
+    {
+        unsigned long long n_inv = mod_pow(n, MOD - 2);
+        for(int i = 0; i < n; ++i)
+        {
+            a[i] = Dtype(a[i] * n_inv % MOD);
+        }
+    }
+}
+
+
+/**
+  c = a * b, where a has na and b has nb coefficients (lowest order first).
+  c must have room for na + nb - 1 coefficients and may not overlap a or b.
+  Products too long for the NTT are done by schoolbook multiplication.
+  */
+void poly_multiply(const Dtype *a, int na, const Dtype *b, int nb, Dtype *c)
+{
+    if(na == 0 || nb == 0) return;
+    int nc = na + nb - 1;
+    if(na < SCHOOLBOOK_LEN || nb < SCHOOLBOOK_LEN || nc > MAX_NTT_LEN)
+    {
+        for(int k = 0; k < nc; ++k) c[k] = 0;
+        for(int i = 0; i < na; ++i)
+        {
+            unsigned long long ai = a[i];
+            for(int j = 0; j < nb; ++j)
+            {
+                c[i + j] = Dtype((c[i + j] + ai * b[j]) % MOD);
+            }
+        }
+        return;
+    }
+    int n = 1;
+    while(n < nc) n <<= 1;
+    Dtype *fa = new Dtype[n]{};
+    Dtype *fb = new Dtype[n]{};
+    for(int i = 0; i < na; ++i) fa[i] = a[i];
+    for(int i = 0; i < nb; ++i) fb[i] = b[i];
+    ntt(fa, n, false);
+    ntt(fb, n, false);
+    for(int i = 0; i < n; ++i)
+    {
+        fa[i] = Dtype((unsigned long long)fa[i] * fb[i] % MOD);
+    }
+    ntt(fa, n, true);
+    for(int i = 0; i < nc; ++i) c[i] = fa[i];
+    delete[] fa;
+    delete[] fb;
+}
+
+
+/**
+  inv = 1 / a mod x^n by Newton iteration: inv <- inv (2 - a inv). a must
+  have at least n coefficients and a[0] != 0.
+  */
+void poly_inverse(const Dtype *a, int n, Dtype *inv)
+{
+    inv[0] = mod_pow(a[0], MOD - 2);
+    Dtype *t = new Dtype[2 * n];
+    Dtype *u = new Dtype[2 * n];
+    for(int cur = 1; cur < n;)
+    {
+        int next = (2 * cur < n) ? 2 * cur : n;
+        //t = a * inv mod x^next
+        poly_multiply(a, next, inv, cur, t);
+        //t = 2 - t
+        for(int i = 0; i < next; ++i)
+        {
+            t[i] = (t[i] == 0) ? 0 : MOD - t[i];
+        }
+        t[0] = (t[0] + 2) % MOD;
+        //inv = inv * t mod x^next
+        poly_multiply(inv, cur, t, next, u);
+        for(int i = 0; i < next; ++i) inv[i] = u[i];
+        cur = next;
+    }
+    delete[] t;
+    delete[] u;
+}
+
+
+/**
+  r = a mod b, where b is monic with nb coefficients. r gets nb - 1
+  coefficients.
+  */
+void poly_remainder(const Dtype *a, int na, const Dtype *b, int nb, Dtype *r)
+{
+    int m = nb - 1;
+    if(na <= m)
+    {
+        for(int i = 0; i < m; ++i) r[i] = (i < na) ? a[i] : 0;
+        return;
+    }
+    //Quotient from the reversed polynomials: rev(q) = rev(a) / rev(b)
+    int dq = na - m;
+    Dtype *ra = new Dtype[dq];
+    Dtype *rb = new Dtype[dq];
+    Dtype *rb_inv = new Dtype[dq];
+    Dtype *q = new Dtype[2 * dq];
+    for(int i = 0; i < dq; ++i)
+    {
+        ra[i] = a[na - 1 - i];
+        rb[i] = (i < nb) ? b[nb - 1 - i] : 0;
+    }
+    poly_inverse(rb, dq, rb_inv);
+    poly_multiply(ra, dq, rb_inv, dq, q);
+    for(int i = 0; i < dq / 2; ++i)
+    {
+        Dtype t = q[i];
+        q[i] = q[dq - 1 - i];
+        q[dq - 1 - i] = t;
+    }
+    //r = a - q b
+    Dtype *qb = new Dtype[dq + nb - 1];
+    poly_multiply(q, dq, b, nb, qb);
+    for(int i = 0; i < m; ++i)
+    {
+        r[i] = (a[i] >= qb[i]) ? a[i] - qb[i] : a[i] + MOD - qb[i];
+    }
+    delete[] ra;
+    delete[] rb;
+    delete[] rb_inv;
+    delete[] q;
+    delete[] qb;
+}
+
+
+/**
+  Horner's rule modulo MOD. coef is lowest order first.
+  */
+Dtype horners_rule(const Dtype *coef, int n_coef, Dtype x)
+{
+    unsigned long long y = 0;
+    for(int i = n_coef - 1; i >= 0; --i)
+    {
+        y = (coef[i] + x * y) % MOD;
+    }
+    return Dtype(y);
+}
+
+
+/**
+  Evaluate at every point by Horner's rule. HORNER_LANES points go through
+  the coefficients together, so that their independent multiply and reduce
+  chains overlap.
+  */
+void multipoint_horner(const Dtype *coef, int n_coef, const Dtype *xs,
+        Dtype *ys, int n_points)
+{
+    int i = 0;
+    for(; i + HORNER_LANES <= n_points; i += HORNER_LANES)
+    {
+        unsigned long long x[HORNER_LANES], y[HORNER_LANES];
+        for(int l = 0; l < HORNER_LANES; ++l)
+        {
+            x[l] = xs[i + l];
+            y[l] = 0;
+        }
+        for(int k = n_coef - 1; k >= 0; --k)
+        {
+            unsigned long long c = coef[k];
+            for(int l = 0; l < HORNER_LANES; ++l)
+            {
+                y[l] = (c + x[l] * y[l]) % MOD;
+            }
+        }
+        for(int l = 0; l < HORNER_LANES; ++l) ys[i + l] = Dtype(y[l]);
+    }
+    for(; i < n_points; ++i)
+    {
+        ys[i] = horners_rule(coef, n_coef, xs[i]);
+    }
+}
+
+
+/**
+  Evaluate at every point using one subproduct tree over all the points.
+  coef is lowest order first.
+  */
+void subproduct_tree_evaluate(const Dtype *coef, int n_coef, const Dtype *xs,
+        Dtype *ys, int n_points)
+{
+    //Pad the points (with 0) to LEAF_POINTS * 2^k
+    int n_leaves = 1;
+    while(n_leaves * LEAF_POINTS < n_points) n_leaves *= 2;
+    int n = n_leaves * LEAF_POINTS;
+    int n_levels = 1;
+    for(int l = n_leaves; l > 1; l /= 2) ++n_levels;
+
+    //Subproduct tree. Level j has n_leaves >> j nodes of size
+    //LEAF_POINTS << j points. Each node is a monic polynomial with
+    //size + 1 coefficients.
+    Dtype **tree = new Dtype*[n_levels];
+    for(int j = 0; j < n_levels; ++j)
+    {
+        int size = LEAF_POINTS << j;
+        tree[j] = new Dtype[(long long)(n_leaves >> j) * (size + 1)];
+    }
+    for(int node = 0; node < n_leaves; ++node)
+    {
+        //Product of (x - x_i) over the block, one factor at a time
+        Dtype *p = tree[0] + node * (LEAF_POINTS + 1);
+        p[0] = 1;
+        for(int k = 0; k < LEAF_POINTS; ++k)
+        {
+            int i = node * LEAF_POINTS + k;
+            unsigned long long neg_x = (i < n_points) ? (MOD - xs[i]) % MOD :
+                0;
+            p[k + 1] = p[k];
+            for(int d = k; d > 0; --d)
+            {
+                p[d] = Dtype((p[d - 1] + neg_x * p[d]) % MOD);
+            }
+            p[0] = Dtype(neg_x * p[0] % MOD);
+        }
+    }
+    for(int j = 1; j < n_levels; ++j)
+    {
+        int size = LEAF_POINTS << j;
+        int child = size / 2 + 1;
+        for(int node = 0; node < (n_leaves >> j); ++node)
+        {
+            const Dtype *left = tree[j - 1] + (2 * node) * child;
+            poly_multiply(left, child, left + child, child,
+                    tree[j] + node * (size + 1));
+        }
+    }
+
+    //Remainder tree, level by level from the root
+    Dtype *rem = new Dtype[n];
+    Dtype *rem_next = new Dtype[n];
+    poly_remainder(coef, n_coef, tree[n_levels - 1], n + 1, rem);
+    for(int j = n_levels - 1; j > 0; --j)
+    {
+        int size = LEAF_POINTS << j;
+        int child = size / 2;
+        for(int node = 0; node < (n_leaves >> j); ++node)
+        {
+            for(int c = 0; c < 2; ++c)
+            {
+                poly_remainder(rem + node * size, size,
+                        tree[j - 1] + (2 * node + c) * (child + 1), child + 1,
+                        rem_next + (2 * node + c) * child);
+            }
+        }
+        Dtype *t = rem;
+        rem = rem_next;
+        rem_next = t;
+    }
+
+    //Leaves: Horner's rule on the remainders
+    for(int i = 0; i < n_points; ++i)
+    {
+        ys[i] = horners_rule(rem + (i / LEAF_POINTS) * LEAF_POINTS,
+                LEAF_POINTS, xs[i]);
+    }
+
+    for(int j = 0; j < n_levels; ++j)
+    {
+        delete[] tree[j];
+    }
+    delete[] tree;
+    delete[] rem;
+    delete[] rem_next;
+}
+
+
+/**
+  Evaluate at every point. coef is lowest order first. The remainder at the
+  root has degree < n_coef whatever the number of points, so the points are
+  split into blocks of about n_coef (LEAF_POINTS * 2^k) points, each with
+  its own subproduct tree. A last block of less than half the size, or a
+  polynomial with fewer than FAST_MIN_LEN coefficients, uses Horner's rule.
+  A polynomial longer than FAST_MAX_LEN is evaluated in pieces.
+  */
+void multipoint_evaluate(const Dtype *coef, int n_coef, const Dtype *xs,
+        Dtype *ys, int n_points)
+{
+    if(n_coef < FAST_MIN_LEN)
+    {
+        multipoint_horner(coef, n_coef, xs, ys, n_points);
+        return;
+    }
+    if(n_coef > FAST_MAX_LEN)
+    {
+        //P = P_0 + x^L P_1 + x^2L P_2 + ... with pieces of L = FAST_MAX_LEN
+        //coefficients, combined by Horner's rule in x^L
+        Dtype *yp = new Dtype[n_points > 0 ? n_points : 1];
+        Dtype *xl = new Dtype[n_points > 0 ? n_points : 1];
+        for(int i = 0; i < n_points; ++i)
+        {
+            ys[i] = 0;
+            xl[i] = mod_pow(xs[i], FAST_MAX_LEN);
+        }
+        int n_pieces = (n_coef + FAST_MAX_LEN - 1) / FAST_MAX_LEN;
+        for(int j = n_pieces - 1; j >= 0; --j)
+        {
+            int beg = j * FAST_MAX_LEN;
+            int len = (n_coef - beg < FAST_MAX_LEN) ? n_coef - beg :
+                FAST_MAX_LEN;
+            multipoint_evaluate(coef + beg, len, xs, yp, n_points);
+            for(int i = 0; i < n_points; ++i)
+            {
+                ys[i] = Dtype(((unsigned long long)ys[i] * xl[i] + yp[i]) %
+                        MOD);
+            }
+        }
+        delete[] yp;
+        delete[] xl;
+        return;
+    }
+    int block = LEAF_POINTS;
+    while(2 * block <= n_coef) block *= 2;
+    for(int beg = 0; beg < n_points; beg += block)
+    {
+        int m = (n_points - beg < block) ? n_points - beg : block;
+        if(2 * m < block)
+        {
+            multipoint_horner(coef, n_coef, xs + beg, ys + beg, m);
+        }
+        else
+        {
+            subproduct_tree_evaluate(coef, n_coef, xs + beg, ys + beg, m);
+        }
+    }
+}
+
+
+/**
+  Read an integer array from terminal and reduce it modulo MOD
+  */
+bool read_array_term(const string what, Dtype **array, int &array_len)
+{
+    cout << "Enter number of " << what << ": ";
+    cin >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    cout << "Enter the " << what << ": ";
+    for(int i = 0; i < array_len; ++i)
+    {
+        long long v;
+        cin >> v;
+        (*array)[i] = Dtype(((v % MOD) + MOD) % MOD);
+    }
+    return true;
+}
+
+
+/**
+  Read an integer array from file and reduce it modulo MOD. The first element
+  in the file should be the number of elements.
+  */
+bool read_array_file(const string filename, Dtype **array, int &array_len)
+{
+    ifstream fp {filename};
+    cout << "Reading input file... ";
+    if(!fp.is_open())
+    {
+        cout << "Error: Input file could not be opened\n";
+        return false;
+    }
+    fp >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    for(int i = 0; i < array_len; ++i)
+    {
+        long long v;
+        fp >> v;
+        (*array)[i] = Dtype(((v % MOD) + MOD) % MOD);
+    }
+    fp.close();
+    cout << "Read " << array_len << " elements." << endl;
+    return true;
+}
+
+
+/**
+  Write array
+  */
+bool write_array_file(const string filename, const Dtype *array,
+        const int array_len)
+{
+    ofstream ofp{filename};
+    if(!ofp.is_open())
+    {
+        cout << "Could not open file for writing.\n";
+        return false;
+    }
+    for(int i = 0; i < array_len; ++i)
+    {
+        ofp << array[i] << endl;
+    }
+    ofp.close();
+    cout << "Written array of length " << array_len << " in ";
+    cout << filename << endl;
+    return true;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Multipoint evaluation of a polynomial modulo " << MOD <<
+        ". Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -i <coefficient file> -x <points file> -o"\
+        " <output file> -c <1|0>" << endl;
+    cout << "   Coefficients must be saved from higher order to lower order"\
+        " (a_n, ..., a_0), with the number of coefficients first. The points"\
+        " file has the number of points first.\n";
+    cout << "   With -c 1, the result is compared with Horner's rule at every"\
+        " point.\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **coef,
+        int &n_coef, Dtype **xs, int &n_points, string &ofilename,
+        bool &compare)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    *coef = nullptr;
+    *xs = nullptr;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input")
+        {
+            if(!read_array_file(string(argv[i + 1]), coef, n_coef))
+            {
+                return false;
+            }
+        }
+        if(arg_opt == "-x" || arg_opt == "--points")
+        {
+            if(!read_array_file(string(argv[i + 1]), xs, n_points))
+            {
+                return false;
+            }
+        }
+        if(arg_opt == "-o" || arg_opt == "--output")
+        {
+            ofilename = string(argv[i + 1]);
+        }
+        if(arg_opt == "-c" || arg_opt == "--compare")
+        {
+            compare = atoi(argv[i + 1]) != 0;
+        }
+    }
+    if(*coef == nullptr)
+    {
+        if(!read_array_term("coefficients", coef, n_coef))
+        {
+            return false;
+        }
+    }
+    if(*xs == nullptr)
+    {
+        if(!read_array_term("points", xs, n_points))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Dtype *coef = nullptr, *xs = nullptr;
+    int n_coef = 0, n_points = 0;
+    string ofilename = "";
+    bool compare = false;
+
+    //Parse and get inputs
+    if(!parse_and_get_inputs(argc, argv, &coef, n_coef, &xs, n_points,
+                ofilename, compare))
+    {
+        delete[] coef;
+        delete[] xs;
+        return 0;
+    }
+
+    //Coefficients are given from the highest order
+    for(int i = 0; i < n_coef / 2; ++i)
+    {
+        Dtype t = coef[i];
+        coef[i] = coef[n_coef - 1 - i];
+        coef[n_coef - 1 - i] = t;
+    }
+
+    Dtype *ys = new Dtype[n_points > 0 ? n_points : 1];
+    clock_t t0 = clock();
+    multipoint_evaluate(coef, n_coef, xs, ys, n_points);
+    t0 = clock() - t0;
+    cout << "Time taken for multipoint evaluation: "
+        << float(t0)/CLOCKS_PER_SEC * 1000 << " ms.\n";
+
+    if(compare)
+    {
+        Dtype *ys_horner = new Dtype[n_points > 0 ? n_points : 1];
+        //One point at a time, independent of multipoint_horner, which
+        //multipoint_evaluate itself uses
+        clock_t t1 = clock();
+        for(int i = 0; i < n_points; ++i)
+        {
+            ys_horner[i] = horners_rule(coef, n_coef, xs[i]);
+        }
+        t1 = clock() - t1;
+        int n_wrong = 0;
+        for(int i = 0; i < n_points; ++i)
+        {
+            n_wrong += (ys[i] != ys_horner[i]);
+        }
+        cout << "Time taken by Horner's rule: "
+            << float(t1)/CLOCKS_PER_SEC * 1000 << " ms. Mismatches: " <<
+            n_wrong << endl;
+        delete[] ys_horner;
+    }
+
+    //Print result
+    if(ofilename.empty())
+    {
+        for(int i = 0; i < n_points; ++i)
+        {
+            cout << "P(" << xs[i] << ") = " << ys[i] << endl;
+        }
+    }
+    else
+    {
+        write_array_file(ofilename, ys, n_points);
+    }
+
+    delete[] coef;
+    delete[] xs;
+    delete[] ys;
+    return 0;
+}
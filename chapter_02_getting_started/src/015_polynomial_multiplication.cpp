@@ -0,0 +1,722 @@
+/**
+  Polynomial multiplication in O(n log n) using the fast Fourier transform.
+
+  The product of two polynomials is the convolution of their coefficients.
+  Transforming both, multiplying point by point and transforming back takes
+  n log n operations instead of n^2. Two transforms are provided:
+  - FFT over complex doubles. The transform is iterative. After the bit
+    reversal permutation, pairs of radix-2 stages are fused into one radix-4
+    pass, so the data is read log4 n times instead of log2 n times. Twiddle
+    factors are precomputed once per length and stored contiguously for each
+    stage, and the butterflies work on 4 doubles at a time with AVX2. Real
+    and imaginary parts are kept in separate arrays. Both real inputs are
+    packed into one complex array (a + i b), so a product needs one forward
+    and one inverse transform.
+  - NTT over the prime field p = 998244353 = 119 * 2^23 + 1. The result is
+    exact modulo p. Values are kept in Montgomery form, so a modular product
+    is two multiplications and a shift instead of a division. Lengths are
+    limited to 2^23.
+  Short products are done by schoolbook multiplication.
+
+  Coefficient files have the format read by read_array in 010_horners_rule:
+  the number of coefficients first, followed by the coefficients from higher
+  order to lower order. The product is written in the same format, so that it
+  can be used as an input again. (Convolution does not depend on the order,
+  so the coefficients are not reversed.)
+
+  Compile with -O2 -march=native to enable AVX2/FMA.
+
+  Complexity: n log n
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+//Input array type
+typedef double Dtype;
+
+//Transform used for the product
+enum METHOD {FFT = 1, NTT = 2};
+
+//Below this number of coefficients in either factor, products are done by
+//schoolbook multiplication
+const int SCHOOLBOOK_LEN = 32;
+
+//Prime modulus of the NTT, a primitive root of it and the largest
+//transform length
+const uint32_t MOD = 998244353;
+const uint32_t ROOT = 3;
+const int NTT_MAX_LEN = 1 << 23;
+
+const double PI = 3.14159265358979323846;
+
+
+/**
+  Precomputed twiddle factors of the FFT of length n. Stage h (combining
+  halves of length h) uses exp(-i pi k / h), k < h, which are stored at
+  wr[h + k], wi[h + k].
+  */
+void fft_twiddles(int n, double *wr, double *wi)
+{
+    for(int h = 1; h < n; h *= 2)
+    {
+        for(int k = 0; k < h; ++k)
+        {
+            double angle = -PI * k / h;
+            wr[h + k] = cos(angle);
+            wi[h + k] = sin(angle);
+        }
+    }
+}
+
+
+/**
+  Bit reversal permutation of a (length n, a power of 2)
+  */
+template <typename T>
+void bit_reverse(T *a, int n)
+{
+    for(int i = 1, j = 0; i < n; ++i)
+    {
+        int bit = n >> 1;
+        for(; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if(i < j)
+        {
+            T t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+}
+
+
+/**
+  Radix-4 butterfly fusing the stages of half lengths h and 2h, for one k.
+  x0..x3 are the elements at k, k + h, k + 2h and k + 3h of a block.
+  */
+inline void fft_butterfly4(double *re, double *im, int x0, int h,
+        double w1r, double w1i, double w2r, double w2i)
+{
+    int x1 = x0 + h, x2 = x0 + 2 * h, x3 = x0 + 3 * h;
+    //Stage h: (x0, x1) and (x2, x3) with w1
+    double t1r = re[x1] * w1r - im[x1] * w1i;
+    double t1i = re[x1] * w1i + im[x1] * w1r;
+    double t3r = re[x3] * w1r - im[x3] * w1i;
+    double t3i = re[x3] * w1i + im[x3] * w1r;
+    double b0r = re[x0] + t1r, b0i = im[x0] + t1i;
+    double b1r = re[x0] - t1r, b1i = im[x0] - t1i;
+    double b2r = re[x2] + t3r, b2i = im[x2] + t3i;
+    double b3r = re[x2] - t3r, b3i = im[x2] - t3i;
+    //Stage 2h: (x0, x2) with w2 and (x1, x3) with w2 exp(-i pi / 2) = -i w2
+    double u2r = b2r * w2r - b2i * w2i;
+    double u2i = b2r * w2i + b2i * w2r;
+    double u3r = b3r * w2i + b3i * w2r;
+    double u3i = -(b3r * w2r - b3i * w2i);
+    re[x0] = b0r + u2r; im[x0] = b0i + u2i;
+    re[x2] = b0r - u2r; im[x2] = b0i - u2i;
+    re[x1] = b1r + u3r; im[x1] = b1i + u3i;
+    re[x3] = b1r - u3r; im[x3] = b1i - u3i;
+}
+
+
+#if defined(__AVX2__)
+/**
+  (ar + i ai) * (br + i bi) for 4 complex numbers
+  */
+inline void complex_mul4(__m256d ar, __m256d ai, __m256d br, __m256d bi,
+        __m256d &cr, __m256d &ci)
+{
+#if defined(__FMA__)
+    cr = _mm256_fmsub_pd(ar, br, _mm256_mul_pd(ai, bi));
+    ci = _mm256_fmadd_pd(ar, bi, _mm256_mul_pd(ai, br));
+#else
+    cr = _mm256_sub_pd(_mm256_mul_pd(ar, br), _mm256_mul_pd(ai, bi));
+    ci = _mm256_add_pd(_mm256_mul_pd(ar, bi), _mm256_mul_pd(ai, br));
+#endif
+}
+
+
+/**
+  fft_butterfly4 for k, ..., k + 3
+  */
+inline void fft_butterfly4_avx(double *re, double *im, int x0, int h,
+        const double *w1r, const double *w1i, const double *w2r,
+        const double *w2i)
+{
+    int x1 = x0 + h, x2 = x0 + 2 * h, x3 = x0 + 3 * h;
+    __m256d wr = _mm256_loadu_pd(w1r), wi = _mm256_loadu_pd(w1i);
+    __m256d t1r, t1i, t3r, t3i;
+    complex_mul4(_mm256_loadu_pd(re + x1), _mm256_loadu_pd(im + x1), wr, wi,
+            t1r, t1i);
+    complex_mul4(_mm256_loadu_pd(re + x3), _mm256_loadu_pd(im + x3), wr, wi,
+            t3r, t3i);
+    __m256d a0r = _mm256_loadu_pd(re + x0), a0i = _mm256_loadu_pd(im + x0);
+    __m256d a2r = _mm256_loadu_pd(re + x2), a2i = _mm256_loadu_pd(im + x2);
+    __m256d b0r = _mm256_add_pd(a0r, t1r), b0i = _mm256_add_pd(a0i, t1i);
+    __m256d b1r = _mm256_sub_pd(a0r, t1r), b1i = _mm256_sub_pd(a0i, t1i);
+    __m256d b2r = _mm256_add_pd(a2r, t3r), b2i = _mm256_add_pd(a2i, t3i);
+    __m256d b3r = _mm256_sub_pd(a2r, t3r), b3i = _mm256_sub_pd(a2i, t3i);
+    wr = _mm256_loadu_pd(w2r);
+    wi = _mm256_loadu_pd(w2i);
+    __m256d u2r, u2i, v3r, v3i;
+    complex_mul4(b2r, b2i, wr, wi, u2r, u2i);
+    complex_mul4(b3r, b3i, wr, wi, v3r, v3i);
+    //u3 = -i v3
+    __m256d u3r = v3i;
+    __m256d u3i = _mm256_sub_pd(_mm256_setzero_pd(), v3r);
+    _mm256_storeu_pd(re + x0, _mm256_add_pd(b0r, u2r));
+    _mm256_storeu_pd(im + x0, _mm256_add_pd(b0i, u2i));
+    _mm256_storeu_pd(re + x2, _mm256_sub_pd(b0r, u2r));
+    _mm256_storeu_pd(im + x2, _mm256_sub_pd(b0i, u2i));
+    _mm256_storeu_pd(re + x1, _mm256_add_pd(b1r, u3r));
+    _mm256_storeu_pd(im + x1, _mm256_add_pd(b1i, u3i));
+    _mm256_storeu_pd(re + x3, _mm256_sub_pd(b1r, u3r));
+    _mm256_storeu_pd(im + x3, _mm256_sub_pd(b1i, u3i));
+}
+#endif
+
+
+/**
+  In place forward FFT of (re, im) of length n (a power of 2), using the
+  twiddles from fft_twiddles.
+  */
+void fft(double *re, double *im, int n, const double *wr, const double *wi)
+{
+    bit_reverse(re, n);
+    bit_reverse(im, n);
+    int h = 1;
+    int log_n = 0;
+    while((1 << log_n) < n) ++log_n;
+    if(log_n % 2 == 1)
+    {
+        //One radix-2 stage, so that the rest pair up
+        for(int i = 0; i < n; i += 2)
+        {
+            double ur = re[i], ui = im[i];
+            re[i] = ur + re[i + 1];
+            im[i] = ui + im[i + 1];
+            re[i + 1] = ur - re[i + 1];
+            im[i + 1] = ui - im[i + 1];
+        }
+        h = 2;
+    }
+    for(; h < n; h *= 4)
+    {
+        for(int i = 0; i < n; i += 4 * h)
+        {
+            int k = 0;
+#if defined(__AVX2__)
+            for(; k + 4 <= h; k += 4)
+            {
+                fft_butterfly4_avx(re, im, i + k, h, wr + h + k, wi + h + k,
+                        wr + 2 * h + k, wi + 2 * h + k);
+            }
+#endif
+            for(; k < h; ++k)
+            {
+                fft_butterfly4(re, im, i + k, h, wr[h + k], wi[h + k],
+                        wr[2 * h + k], wi[2 * h + k]);
+            }
+        }
+    }
+}
+
+
+/**
+  In place inverse FFT, including the division by n:
+  ifft(x) = conj(fft(conj(x))) / n
+  */
+void ifft(double *re, double *im, int n, const double *wr, const double *wi)
+{
+    for(int i = 0; i < n; ++i) im[i] = -im[i];
+    fft(re, im, n, wr, wi);
+    double scale = 1.0 / n;
+    for(int i = 0; i < n; ++i)
+    {
+        re[i] *= scale;
+        im[i] *= -scale;
+    }
+}
+
+
+/**
+  c = a * b by schoolbook multiplication. c must have room for na + nb - 1
+  coefficients.
+  */
+void schoolbook_multiply(const Dtype *a, int na, const Dtype *b, int nb,
+        Dtype *c)
+{
+    for(int k = 0; k < na + nb - 1; ++k) c[k] = 0;
+    for(int i = 0; i < na; ++i)
+    {
+        for(int j = 0; j < nb; ++j)
+        {
+            c[i + j] += a[i] * b[j];
+        }
+    }
+}
+
+
+/**
+  c = a * b using the FFT. c must have room for na + nb - 1 coefficients.
+  */
+void fft_multiply(const Dtype *a, int na, const Dtype *b, int nb, Dtype *c)
+{
+    if(na <= 0 || nb <= 0) return;
+    if(na < SCHOOLBOOK_LEN || nb < SCHOOLBOOK_LEN)
+    {
+        schoolbook_multiply(a, na, b, nb, c);
+        return;
+    }
+    int nc = na + nb - 1;
+    int n = 1;
+    while(n < nc) n <<= 1;
+    double *wr = new double[n];
+    double *wi = new double[n];
+    double *re = new double[n]{};
+    double *im = new double[n]{};
+    double *pr = new double[n];
+    double *pi = new double[n];
+    fft_twiddles(n, wr, wi);
+
+    //Pack both real inputs into one complex array
+    for(int i = 0; i < na; ++i) re[i] = a[i];
+    for(int i = 0; i < nb; ++i) im[i] = b[i];
+    fft(re, im, n, wr, wi);
+
+    //With C = A + i B, A B = (C[k]^2 - conj(C[n - k])^2) / 4i
+    for(int k = 0; k < n; ++k)
+    {
+        int j = (n - k) & (n - 1);
+        double cr = re[k], ci = im[k], dr = re[j], di = im[j];
+        double xr = cr * cr - ci * ci - dr * dr + di * di;
+        double xi = 2 * (cr * ci + dr * di);
+        pr[k] = 0.25 * xi;
+        pi[k] = -0.25 * xr;
+    }
+    ifft(pr, pi, n, wr, wi);
+    for(int i = 0; i < nc; ++i) c[i] = pr[i];
+
+    delete[] wr;
+    delete[] wi;
+    delete[] re;
+    delete[] im;
+    delete[] pr;
+    delete[] pi;
+}
+
+
+/**
+  -MOD^-1 mod 2^32, by Newton iteration
+  */
+uint32_t montgomery_ninv()
+{
+    uint32_t inv = MOD;
+    for(int i = 0; i < 5; ++i) inv *= 2 - MOD * inv;
+    return -inv;
+}
+
+const uint32_t MONT_NINV = montgomery_ninv();
+//2^64 mod MOD, to convert into Montgomery form
+const uint32_t MONT_R2 = uint32_t((((uint64_t(1) << 32) % MOD) *
+            ((uint64_t(1) << 32) % MOD)) % MOD);
+
+
+/**
+  t / 2^32 mod MOD, for t < MOD 2^32
+  */
+inline uint32_t montgomery_reduce(uint64_t t)
+{
+    uint32_t m = uint32_t(t) * MONT_NINV;
+    uint32_t u = uint32_t((t + uint64_t(m) * MOD) >> 32);
+    return (u >= MOD) ? u - MOD : u;
+}
+
+
+/**
+  a b / 2^32 mod MOD. a b is an ordinary product when one of them is in
+  Montgomery form and the result stays in the form of the other.
+  */
+inline uint32_t montgomery_multiply(uint32_t a, uint32_t b)
+{
+    return montgomery_reduce(uint64_t(a) * b);
+}
+
+
+inline uint32_t to_montgomery(uint32_t a)
+{
+    return montgomery_multiply(a, MONT_R2);
+}
+
+
+/**
+  b^e mod MOD, in ordinary form
+  */
+uint32_t mod_pow(uint32_t b, uint64_t e)
+{
+    uint64_t r = 1, base = b;
+    while(e > 0)
+    {
+        if(e & 1) r = r * base % MOD;
+        base = base * base % MOD;
+        e >>= 1;
+    }
+    return uint32_t(r);
+}
+
+
+/**
+  Twiddle factors of the NTT of length n in Montgomery form, in the layout
+  of fft_twiddles. The inverse transform uses the inverse roots.
+  */
+void ntt_twiddles(int n, uint32_t *w, bool invert)
+{
+    for(int h = 1; h < n; h *= 2)
+    {
+        uint32_t root = mod_pow(ROOT, (MOD - 1) / (2 * h));
+        if(invert) root = mod_pow(root, MOD - 2);
+        root = to_montgomery(root);
+        w[h] = to_montgomery(1);
+        for(int k = 1; k < h; ++k)
+        {
+            w[h + k] = montgomery_multiply(w[h + k - 1], root);
+        }
+    }
+}
+
+
+/**
+  In place NTT of a (Montgomery form, length n a power of 2)
+  */
+void ntt(uint32_t *a, int n, const uint32_t *w)
+{
+    bit_reverse(a, n);
+    for(int h = 1; h < n; h *= 2)
+    {
+        for(int i = 0; i < n; i += 2 * h)
+        {
+            for(int k = 0; k < h; ++k)
+            {
+                uint32_t u = a[i + k];
+                uint32_t v = montgomery_multiply(a[i + k + h], w[h + k]);
+                a[i + k] = (u + v >= MOD) ? u + v - MOD : u + v;
+                a[i + k + h] = (u >= v) ? u - v : u + MOD - v;
+            }
+        }
+    }
+}
+
+
+/**
+  c = a * b mod MOD using the NTT. Inputs are in ordinary form and reduced
+  modulo MOD. c must have room for na + nb - 1 coefficients. Returns false
+  if the product is too long for the transform.
+  */
+bool ntt_multiply(const uint32_t *a, int na, const uint32_t *b, int nb,
+        uint32_t *c)
+{
+    if(na <= 0 || nb <= 0) return true;
+    int nc = na + nb - 1;
+    if(na < SCHOOLBOOK_LEN || nb < SCHOOLBOOK_LEN)
+    {
+        for(int k = 0; k < nc; ++k) c[k] = 0;
+        for(int i = 0; i < na; ++i)
+        {
+            for(int j = 0; j < nb; ++j)
+            {
+                c[i + j] = uint32_t((c[i + j] + uint64_t(a[i]) * b[j]) % MOD);
+            }
+        }
+        return true;
+    }
+    if(nc > NTT_MAX_LEN)
+    {
+        cout << "Error: NTT supports products of up to " << NTT_MAX_LEN <<
+            " coefficients\n";
+        return false;
+    }
+    int n = 1;
+    while(n < nc) n <<= 1;
+    uint32_t *w = new uint32_t[n];
+    uint32_t *fa = new uint32_t[n]{};
+    uint32_t *fb = new uint32_t[n]{};
+    for(int i = 0; i < na; ++i) fa[i] = to_montgomery(a[i]);
+    for(int i = 0; i < nb; ++i) fb[i] = to_montgomery(b[i]);
+    ntt_twiddles(n, w, false);
+    ntt(fa, n, w);
+    ntt(fb, n, w);
+    for(int i = 0; i < n; ++i)
+    {
+        fa[i] = montgomery_multiply(fa[i], fb[i]);
+    }
+    ntt_twiddles(n, w, true);
+    ntt(fa, n, w);
+    //Multiplying by the ordinary 1/n divides by n and leaves the
+    //Montgomery form in one step
+    uint32_t n_inv = mod_pow(n, MOD - 2);
+    for(int i = 0; i < nc; ++i)
+    {
+        c[i] = montgomery_multiply(fa[i], n_inv);
+    }
+    delete[] w;
+    delete[] fa;
+    delete[] fb;
+    return true;
+}
+
+
+/**
+  Read input array from terminal
+  */
+void read_array_term(const string what, Dtype **array, int &array_len)
+{
+    cout << "Enter number of coefficients of " << what << ": ";
+    cin >> array_len;
+    if(array_len <= 0) return;
+    *array = new Dtype[array_len];
+    cout << "Enter the coefficients: ";
+    for(int i = 0; i < array_len; ++i)
+    {
+        cin >> (*array)[i];
+    }
+}
+
+
+/**
+  Read input array from file
+  */
+bool read_array(const char *ifile, Dtype **array, int &array_len)
+{
+    ifstream in_file(ifile);
+    if(in_file.is_open())
+    {
+        in_file >> array_len;
+        if(array_len <= 0) return true;
+        *array = new Dtype[array_len];
+        for(int i = 0; i < array_len; ++i)
+        {
+            in_file >> (*array)[i];
+        }
+        in_file.close();
+        return true;
+    }
+    else
+    {
+        cout << "Error: Could not open " << ifile << endl;
+        return false;
+    }
+}
+
+
+/**
+  Write array in the format of read_array
+  */
+bool write_array(const string filename, const Dtype *array,
+        const int array_len)
+{
+    ofstream ofp{filename};
+    if(!ofp.is_open())
+    {
+        cout << "Could not open file for writing.\n";
+        return false;
+    }
+    ofp.precision(17);
+    ofp << array_len << endl;
+    for(int i = 0; i < array_len; ++i)
+    {
+        ofp << array[i] << endl;
+    }
+    ofp.close();
+    cout << "Written array of length " << array_len << " in ";
+    cout << filename << endl;
+    return true;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Polynomial multiplication. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -a <coefficient file> -b <coefficient file>"\
+        " -o <output file> -m <method> -c <1|0>" << endl;
+    cout << "   Coefficients are saved from higher order to lower order"\
+        " (a_n, ..., a_0), with the number of coefficients first.\n";
+    cout << "   Method: 1 for FFT over doubles (default), 2 for NTT modulo " <<
+        MOD << " (coefficients are rounded to integers).\n";
+    cout << "   With -c 1, the result is compared with schoolbook"\
+        " multiplication.\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **a, int &na,
+        Dtype **b, int &nb, string &ofilename, METHOD &method, bool &compare)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-a")
+        {
+            if(!read_array(argv[i + 1], a, na)) return false;
+        }
+        if(arg_opt == "-b")
+        {
+            if(!read_array(argv[i + 1], b, nb)) return false;
+        }
+        if(arg_opt == "-o" || arg_opt == "--output")
+        {
+            ofilename = string(argv[i + 1]);
+        }
+        if(arg_opt == "-m" || arg_opt == "--method")
+        {
+            method = (atoi(argv[i + 1]) == 2) ? NTT : FFT;
+        }
+        if(arg_opt == "-c" || arg_opt == "--compare")
+        {
+            compare = atoi(argv[i + 1]) != 0;
+        }
+    }
+    if(*a == nullptr) read_array_term("the first polynomial", a, na);
+    if(*b == nullptr) read_array_term("the second polynomial", b, nb);
+    if(na <= 0 || nb <= 0)
+    {
+        cout << "Error: Both polynomials must have coefficients\n";
+        return false;
+    }
+    return true;
+}
+
+
+/**
+  Rounds to an integer modulo MOD
+  */
+uint32_t to_field(Dtype v)
+{
+    long long r = llround(v) % (long long)MOD;
+    return uint32_t(r < 0 ? r + MOD : r);
+}
+
+
+int main(int argc, char **argv)
+{
+    Dtype *a = nullptr, *b = nullptr;
+    int na = 0, nb = 0;
+    string ofilename = "";
+    METHOD method = FFT;
+    bool compare = false;
+
+    if(!parse_and_get_inputs(argc, argv, &a, na, &b, nb, ofilename, method,
+                compare))
+    {
+        delete[] a;
+        delete[] b;
+        return 0;
+    }
+
+    int nc = na + nb - 1;
+    Dtype *c = new Dtype[nc];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    if(method == FFT)
+    {
+        fft_multiply(a, na, b, nb, c);
+    }
+    else
+    {
+        uint32_t *fa = new uint32_t[na];
+        uint32_t *fb = new uint32_t[nb];
+        uint32_t *fc = new uint32_t[nc];
+        for(int i = 0; i < na; ++i) fa[i] = to_field(a[i]);
+        for(int i = 0; i < nb; ++i) fb[i] = to_field(b[i]);
+        bool ok = ntt_multiply(fa, na, fb, nb, fc);
+        for(int i = 0; i < nc; ++i) c[i] = ok ? fc[i] : 0;
+        delete[] fa;
+        delete[] fb;
+        delete[] fc;
+    }
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << "Product of " << na << " x " << nb << " coefficients took " <<
+        time.count() * 1000 << " ms." << endl;
+
+    if(compare)
+    {
+        Dtype *d = new Dtype[nc];
+        t0 = chrono::steady_clock::now();
+        schoolbook_multiply(a, na, b, nb, d);
+        time = chrono::steady_clock::now() - t0;
+        double max_err = 0;
+        int n_wrong = 0;
+        for(int i = 0; i < nc; ++i)
+        {
+            if(method == FFT)
+            {
+                max_err = fmax(max_err, fabs(c[i] - d[i]));
+            }
+            else
+            {
+                n_wrong += (to_field(d[i]) != uint32_t(c[i]));
+            }
+        }
+        cout << "Schoolbook multiplication took " << time.count() * 1000 <<
+            " ms. ";
+        if(method == FFT)
+        {
+            cout << "Maximum absolute difference: " << max_err << endl;
+        }
+        else
+        {
+            cout << "Mismatches: " << n_wrong << endl;
+        }
+        delete[] d;
+    }
+
+    if(ofilename.empty())
+    {
+        cout << "Product (from higher order): ";
+        for(int i = 0; i < nc; ++i)
+        {
+            cout << c[i] << " ";
+        }
+        cout << endl;
+    }
+    else
+    {
+        write_array(ofilename, c, nc);
+    }
+
+    delete[] a;
+    delete[] b;
+    delete[] c;
+    return 0;
+}
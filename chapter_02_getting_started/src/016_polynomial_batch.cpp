@@ -0,0 +1,599 @@
+/**
+  Batch evaluation of many different small polynomials, each at its own
+  point, by Horner's rule.
+
+  Evaluating one polynomial at a time is a chain of dependent multiply-adds
+  that uses one SIMD lane. Here the polynomials are stored as a structure of
+  arrays: they are split into blocks of LANES polynomials, and inside a block
+  the coefficients are transposed by degree, so that row r holds the r-th
+  coefficient (from the highest order) of all the polynomials of the block.
+  Horner's rule then runs on all the lanes at once:
+  y = y * x + row_r, one SIMD multiply-add per row for LANES polynomials.
+  With AVX2 a block is 2 registers of 8 floats, with AVX-512 one register of
+  16. Two blocks are evaluated together, so that several independent FMA
+  chains hide the latency of each other.
+
+  Polynomials of different degrees are padded with leading zero
+  coefficients up to the longest polynomial of their block, which do not
+  change the value. Each block is stored with its own length, so sorting the
+  polynomials by degree keeps both the padding and the work small.
+
+  Batch file format (binary, native byte order):
+  int32 n_polys, int32 lens[n_polys], then the coefficients of each
+  polynomial as float, from higher order to lower order.
+
+  Compile with -O2 -march=native to enable AVX2/FMA or AVX-512.
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#if defined(__AVX2__) || defined(__AVX512F__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+//Input array type
+typedef float Dtype;
+
+//Number of polynomials in a block of the structure of arrays
+const int LANES = 16;
+
+//Degrees of the polynomials generated with -g
+const int GEN_MIN_LEN = 5;
+const int GEN_MAX_LEN = 33;
+
+
+/**
+  Polynomials in structure of arrays layout. Block b has LANES polynomials
+  of up to block_len[b] coefficients. They are at coef + block_off[b], row
+  by row (LANES values per row). Missing polynomials of the last block are
+  zero.
+  */
+struct PolyBatch
+{
+    int n_polys;
+    int n_blocks;
+    int max_len;
+    Dtype *coef;
+    int *block_len;
+    size_t *block_off;
+};
+
+
+/**
+  Free the batch
+  */
+void poly_batch_free(PolyBatch &batch)
+{
+    delete[] batch.coef;
+    delete[] batch.block_len;
+    delete[] batch.block_off;
+    batch.coef = nullptr;
+    batch.block_len = nullptr;
+    batch.block_off = nullptr;
+    batch.n_polys = batch.n_blocks = batch.max_len = 0;
+}
+
+
+/**
+  Build the batch from n_polys polynomials. polys[p] has lens[p] coefficients
+  from higher order to lower order (as horners_rule takes them).
+  */
+bool poly_batch_build(const Dtype * const *polys, const int *lens,
+        int n_polys, PolyBatch &batch)
+{
+    batch.n_polys = n_polys;
+    batch.n_blocks = (n_polys + LANES - 1) / LANES;
+    batch.max_len = 0;
+    batch.coef = nullptr;
+    batch.block_len = nullptr;
+    batch.block_off = nullptr;
+    for(int p = 0; p < n_polys; ++p)
+    {
+        if(lens[p] < 0)
+        {
+            cout << "Error: Polynomial " << p << " has negative length\n";
+            return false;
+        }
+        if(lens[p] > batch.max_len) batch.max_len = lens[p];
+    }
+    batch.block_len = new int[batch.n_blocks + 1]{};
+    batch.block_off = new size_t[batch.n_blocks + 1];
+    for(int p = 0; p < n_polys; ++p)
+    {
+        int b = p / LANES;
+        if(lens[p] > batch.block_len[b]) batch.block_len[b] = lens[p];
+    }
+    //Each block takes its own length only
+    size_t total = 0;
+    for(int b = 0; b < batch.n_blocks; ++b)
+    {
+        batch.block_off[b] = total;
+        total += (size_t)batch.block_len[b] * LANES;
+    }
+    batch.block_off[batch.n_blocks] = total;
+    batch.coef = new Dtype[total + 1]{};
+    for(int p = 0; p < n_polys; ++p)
+    {
+        int b = p / LANES, lane = p % LANES;
+        Dtype *block = batch.coef + batch.block_off[b];
+        //Pad with leading zeros up to the length of the block
+        int pad = batch.block_len[b] - lens[p];
+        for(int k = 0; k < lens[p]; ++k)
+        {
+            block[(pad + k) * LANES + lane] = polys[p][k];
+        }
+    }
+    return true;
+}
+
+
+/**
+  Horner's rule on one block, written to ys[0 .. LANES - 1]
+  */
+inline void poly_block_evaluate(const Dtype *block, int len, const Dtype *xs,
+        Dtype *ys)
+{
+    Dtype y[LANES] = {};
+    for(int r = 0; r < len; ++r)
+    {
+        for(int lane = 0; lane < LANES; ++lane)
+        {
+            y[lane] = y[lane] * xs[lane] + block[r * LANES + lane];
+        }
+    }
+    for(int lane = 0; lane < LANES; ++lane) ys[lane] = y[lane];
+}
+
+
+/**
+  Evaluate polynomial p of the batch at xs[p] for all p. Results are written
+  to ys.
+  */
+void poly_batch_evaluate(const PolyBatch &batch, const Dtype *xs, Dtype *ys)
+{
+    int b = 0;
+    int full_blocks = batch.n_polys / LANES;
+#if defined(__AVX512F__)
+    //2 blocks of one register each
+    for(; b + 2 <= full_blocks; b += 2)
+    {
+        const Dtype *b0 = batch.coef + batch.block_off[b];
+        const Dtype *b1 = batch.coef + batch.block_off[b + 1];
+        int n0 = batch.block_len[b], n1 = batch.block_len[b + 1];
+        int n = min(n0, n1);
+        __m512 x0 = _mm512_loadu_ps(xs + b * LANES);
+        __m512 x1 = _mm512_loadu_ps(xs + b * LANES + 16);
+        __m512 y0 = _mm512_setzero_ps(), y1 = y0;
+        //Leading rows of the longer block alone, then the last n rows of
+        //both together
+        for(int r = 0; r < n0 - n; ++r)
+        {
+            y0 = _mm512_fmadd_ps(y0, x0, _mm512_loadu_ps(b0 + r * LANES));
+        }
+        for(int r = 0; r < n1 - n; ++r)
+        {
+            y1 = _mm512_fmadd_ps(y1, x1, _mm512_loadu_ps(b1 + r * LANES));
+        }
+        b0 += (size_t)(n0 - n) * LANES;
+        b1 += (size_t)(n1 - n) * LANES;
+        for(int r = 0; r < n; ++r)
+        {
+            y0 = _mm512_fmadd_ps(y0, x0, _mm512_loadu_ps(b0 + r * LANES));
+            y1 = _mm512_fmadd_ps(y1, x1, _mm512_loadu_ps(b1 + r * LANES));
+        }
+        _mm512_storeu_ps(ys + b * LANES, y0);
+        _mm512_storeu_ps(ys + b * LANES + 16, y1);
+    }
+#elif defined(__AVX2__) && defined(__FMA__)
+    //2 blocks of two registers each
+    for(; b + 2 <= full_blocks; b += 2)
+    {
+        const Dtype *b0 = batch.coef + batch.block_off[b];
+        const Dtype *b1 = batch.coef + batch.block_off[b + 1];
+        int n0 = batch.block_len[b], n1 = batch.block_len[b + 1];
+        int n = min(n0, n1);
+        const Dtype *x = xs + b * LANES;
+        __m256 x0 = _mm256_loadu_ps(x), x1 = _mm256_loadu_ps(x + 8);
+        __m256 x2 = _mm256_loadu_ps(x + 16), x3 = _mm256_loadu_ps(x + 24);
+        __m256 y0 = _mm256_setzero_ps(), y1 = y0, y2 = y0, y3 = y0;
+        //Leading rows of the longer block alone, then the last n rows of
+        //both together
+        for(int r = 0; r < n0 - n; ++r)
+        {
+            y0 = _mm256_fmadd_ps(y0, x0, _mm256_loadu_ps(b0 + r * LANES));
+            y1 = _mm256_fmadd_ps(y1, x1, _mm256_loadu_ps(b0 + r * LANES + 8));
+        }
+        for(int r = 0; r < n1 - n; ++r)
+        {
+            y2 = _mm256_fmadd_ps(y2, x2, _mm256_loadu_ps(b1 + r * LANES));
+            y3 = _mm256_fmadd_ps(y3, x3, _mm256_loadu_ps(b1 + r * LANES + 8));
+        }
+        b0 += (size_t)(n0 - n) * LANES;
+        b1 += (size_t)(n1 - n) * LANES;
+        for(int r = 0; r < n; ++r)
+        {
+            y0 = _mm256_fmadd_ps(y0, x0, _mm256_loadu_ps(b0 + r * LANES));
+            y1 = _mm256_fmadd_ps(y1, x1, _mm256_loadu_ps(b0 + r * LANES + 8));
+            y2 = _mm256_fmadd_ps(y2, x2, _mm256_loadu_ps(b1 + r * LANES));
+            y3 = _mm256_fmadd_ps(y3, x3, _mm256_loadu_ps(b1 + r * LANES + 8));
+        }
+        Dtype *y = ys + b * LANES;
+        _mm256_storeu_ps(y, y0);
+        _mm256_storeu_ps(y + 8, y1);
+        _mm256_storeu_ps(y + 16, y2);
+        _mm256_storeu_ps(y + 24, y3);
+    }
+#elif defined(__SSE2__)
+    //1 block of four registers
+    for(; b < full_blocks; ++b)
+    {
+        const Dtype *b0 = batch.coef + batch.block_off[b];
+        const Dtype *x = xs + b * LANES;
+        __m128 x0 = _mm_loadu_ps(x), x1 = _mm_loadu_ps(x + 4);
+        __m128 x2 = _mm_loadu_ps(x + 8), x3 = _mm_loadu_ps(x + 12);
+        __m128 y0 = _mm_setzero_ps(), y1 = y0, y2 = y0, y3 = y0;
+        for(int r = 0; r < batch.block_len[b]; ++r)
+        {
+            const Dtype *row = b0 + r * LANES;
+            y0 = _mm_add_ps(_mm_mul_ps(y0, x0), _mm_loadu_ps(row));
+            y1 = _mm_add_ps(_mm_mul_ps(y1, x1), _mm_loadu_ps(row + 4));
+            y2 = _mm_add_ps(_mm_mul_ps(y2, x2), _mm_loadu_ps(row + 8));
+            y3 = _mm_add_ps(_mm_mul_ps(y3, x3), _mm_loadu_ps(row + 12));
+        }
+        Dtype *y = ys + b * LANES;
+        _mm_storeu_ps(y, y0);
+        _mm_storeu_ps(y + 4, y1);
+        _mm_storeu_ps(y + 8, y2);
+        _mm_storeu_ps(y + 12, y3);
+    }
+#endif
+    for(; b < full_blocks; ++b)
+    {
+        poly_block_evaluate(batch.coef + batch.block_off[b],
+                batch.block_len[b], xs + b * LANES, ys + b * LANES);
+    }
+    //Last partial block, through buffers of LANES points
+    if(b < batch.n_blocks)
+    {
+        Dtype x[LANES] = {}, y[LANES];
+        int n_tail = batch.n_polys - b * LANES;
+        for(int lane = 0; lane < n_tail; ++lane) x[lane] = xs[b * LANES + lane];
+        poly_block_evaluate(batch.coef + batch.block_off[b],
+                batch.block_len[b], x, y);
+        for(int lane = 0; lane < n_tail; ++lane) ys[b * LANES + lane] = y[lane];
+    }
+}
+
+
+/**
+  Horner's rule for one polynomial
+  */
+Dtype horners_rule(const Dtype *array, int array_len, Dtype x)
+{
+    Dtype y = 0;
+    for(int i = 0; i < array_len; ++i)
+    {
+        y = array[i] + x * y;
+    }
+    return y;
+}
+
+
+/**
+  Free polynomials as read from the input
+  */
+void free_polys(Dtype **polys, int *lens, int n_polys)
+{
+    if(polys != nullptr)
+    {
+        for(int p = 0; p < n_polys; ++p) delete[] polys[p];
+    }
+    delete[] polys;
+    delete[] lens;
+}
+
+
+/**
+  Read a batch file. The polynomials are returned one array each, as in the
+  file.
+  */
+bool read_batch_file(const string filename, Dtype ***polys_out,
+        int **lens_out, int &n_out)
+{
+    ifstream fp(filename, ios::binary);
+    if(!fp.is_open())
+    {
+        cout << "Error: Could not open " << filename << endl;
+        return false;
+    }
+    int32_t n_polys = 0;
+    fp.read((char *)&n_polys, sizeof(n_polys));
+    if(!fp || n_polys < 0)
+    {
+        cout << "Error: Invalid batch file\n";
+        return false;
+    }
+    int *lens = new int[n_polys > 0 ? n_polys : 1];
+    Dtype **polys = new Dtype*[n_polys > 0 ? n_polys : 1]{};
+    bool ok = true;
+    for(int p = 0; p < n_polys && ok; ++p)
+    {
+        int32_t len;
+        fp.read((char *)&len, sizeof(len));
+        lens[p] = len;
+        ok = fp && len >= 0;
+    }
+    for(int p = 0; p < n_polys && ok; ++p)
+    {
+        polys[p] = new Dtype[lens[p] > 0 ? lens[p] : 1];
+        fp.read((char *)polys[p], sizeof(Dtype) * lens[p]);
+        ok = bool(fp);
+    }
+    if(!ok)
+    {
+        cout << "Error: Batch file is truncated\n";
+        free_polys(polys, lens, n_polys);
+        return false;
+    }
+    *polys_out = polys;
+    *lens_out = lens;
+    n_out = n_polys;
+    return true;
+}
+
+
+/**
+  Write n_polys random polynomials of GEN_MIN_LEN to GEN_MAX_LEN
+  coefficients in [-1, 1) to a batch file, and as many random points in
+  [-1, 1) to a points file.
+  */
+bool generate_batch_files(int n_polys, const string batch_file,
+        const string points_file)
+{
+    ofstream fp(batch_file, ios::binary);
+    ofstream fx(points_file);
+    if(!fp.is_open() || !fx.is_open())
+    {
+        cout << "Could not open file for writing.\n";
+        return false;
+    }
+    int32_t n = n_polys;
+    fp.write((const char *)&n, sizeof(n));
+    int32_t *lens = new int32_t[n_polys > 0 ? n_polys : 1];
+    for(int p = 0; p < n_polys; ++p)
+    {
+        lens[p] = GEN_MIN_LEN + rand() % (GEN_MAX_LEN - GEN_MIN_LEN + 1);
+        fp.write((const char *)&lens[p], sizeof(lens[p]));
+    }
+    for(int p = 0; p < n_polys; ++p)
+    {
+        for(int k = 0; k < lens[p]; ++k)
+        {
+            Dtype c = Dtype(rand()) / RAND_MAX * 2 - 1;
+            fp.write((const char *)&c, sizeof(c));
+        }
+    }
+    fx << n_polys << endl;
+    for(int p = 0; p < n_polys; ++p)
+    {
+        fx << Dtype(rand()) / RAND_MAX * 2 - 1 << endl;
+    }
+    delete[] lens;
+    cout << "Written " << n_polys << " polynomials in " << batch_file <<
+        " and points in " << points_file << endl;
+    return true;
+}
+
+
+/**
+  Read polynomials and points from terminal
+  */
+bool read_batch_term(Dtype ***polys_out, int **lens_out, int &n_out,
+        Dtype **xs, int &n_points)
+{
+    int n_polys;
+    cout << "Enter number of polynomials: ";
+    cin >> n_polys;
+    if(n_polys <= 0) return false;
+    int *lens = new int[n_polys];
+    Dtype **polys = new Dtype*[n_polys]{};
+    for(int p = 0; p < n_polys; ++p)
+    {
+        cout << "Enter number of coefficients of polynomial " << p << ": ";
+        cin >> lens[p];
+        if(lens[p] < 0) lens[p] = 0;
+        polys[p] = new Dtype[lens[p] > 0 ? lens[p] : 1];
+        cout << "Enter the coefficients from higher order: ";
+        for(int k = 0; k < lens[p]; ++k) cin >> polys[p][k];
+    }
+    *xs = new Dtype[n_polys];
+    n_points = n_polys;
+    cout << "Enter the " << n_polys << " points: ";
+    for(int p = 0; p < n_polys; ++p) cin >> (*xs)[p];
+    *polys_out = polys;
+    *lens_out = lens;
+    n_out = n_polys;
+    return true;
+}
+
+
+/**
+  Read input array from file. The first element should be the number of
+  elements.
+  */
+bool read_array(const string filename, Dtype **array, int &array_len)
+{
+    ifstream in_file(filename);
+    if(!in_file.is_open())
+    {
+        cout << "Error: Could not open " << filename << endl;
+        return false;
+    }
+    in_file >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    for(int i = 0; i < array_len; ++i)
+    {
+        in_file >> (*array)[i];
+    }
+    in_file.close();
+    return true;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Batch evaluation of many polynomials. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -b <batch file> -x <points file> -o"\
+        " <output file> -c <1|0>" << endl;
+    cout << "   Evaluates polynomial p of the binary batch file at point p of"\
+        " the points file (number of points first). With -c 1, the result is"\
+        " compared with Horner's rule on each polynomial.\n\n";
+    cout << "3. " << command << " -g <number of polynomials> -b <batch file>"\
+        " -x <points file>" << endl;
+    cout << "   Writes random polynomials of " << GEN_MIN_LEN - 1 << " to " <<
+        GEN_MAX_LEN - 1 << " degrees and random points.\n";
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return 0;
+    }
+    string batch_file = "", points_file = "", ofilename = "";
+    int n_generate = 0;
+    bool compare = false;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return 0;
+        }
+        if(arg_opt == "-b" || arg_opt == "--batch") batch_file = argv[i + 1];
+        if(arg_opt == "-x" || arg_opt == "--points") points_file = argv[i + 1];
+        if(arg_opt == "-o" || arg_opt == "--output") ofilename = argv[i + 1];
+        if(arg_opt == "-g") n_generate = atoi(argv[i + 1]);
+        if(arg_opt == "-c") compare = atoi(argv[i + 1]) != 0;
+    }
+
+    if(n_generate > 0)
+    {
+        generate_batch_files(n_generate, batch_file, points_file);
+        return 0;
+    }
+
+    PolyBatch batch = {0, 0, 0, nullptr, nullptr, nullptr};
+    Dtype **polys = nullptr;
+    int *lens = nullptr;
+    int n_polys = 0;
+    Dtype *xs = nullptr;
+    int n_points = 0;
+    bool ok;
+    if(batch_file.empty())
+    {
+        ok = read_batch_term(&polys, &lens, n_polys, &xs, n_points);
+    }
+    else
+    {
+        ok = read_batch_file(batch_file, &polys, &lens, n_polys) &&
+            read_array(points_file, &xs, n_points);
+        if(ok && n_points != n_polys)
+        {
+            cout << "Error: " << n_polys << " polynomials but " <<
+                n_points << " points\n";
+            ok = false;
+        }
+    }
+    ok = ok && poly_batch_build(polys, lens, n_polys, batch);
+    if(ok && !batch_file.empty())
+    {
+        cout << "Read " << n_polys << " polynomials of up to " <<
+            batch.max_len << " coefficients." << endl;
+    }
+    //The polynomials as read are kept only as the reference for -c
+    if(!ok || !compare)
+    {
+        free_polys(polys, lens, n_polys);
+        polys = nullptr;
+        lens = nullptr;
+    }
+    if(!ok)
+    {
+        poly_batch_free(batch);
+        delete[] xs;
+        return 0;
+    }
+
+    Dtype *ys = new Dtype[n_points > 0 ? n_points : 1];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    poly_batch_evaluate(batch, xs, ys);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << "Batch evaluation of " << n_points << " polynomials took " <<
+        time.count() * 1000 << " ms." << endl;
+
+    if(compare)
+    {
+        //Horner's rule on each polynomial as read, independent of the
+        //layout of the batch
+        Dtype *y1 = new Dtype[n_points > 0 ? n_points : 1];
+        t0 = chrono::steady_clock::now();
+        for(int p = 0; p < n_points; ++p)
+        {
+            y1[p] = horners_rule(polys[p], lens[p], xs[p]);
+        }
+        time = chrono::steady_clock::now() - t0;
+        double max_err = 0;
+        for(int p = 0; p < n_points; ++p)
+        {
+            max_err = fmax(max_err, fabs(y1[p] - ys[p]));
+        }
+        cout << "Horner's rule on each polynomial took " << time.count() *
+            1000 << " ms. Maximum absolute difference: " << max_err << endl;
+        delete[] y1;
+        free_polys(polys, lens, n_polys);
+    }
+
+    if(ofilename.empty())
+    {
+        for(int p = 0; p < n_points; ++p)
+        {
+            cout << "P_" << p << "(" << xs[p] << ") = " << ys[p] << endl;
+        }
+    }
+    else
+    {
+        ofstream ofp(ofilename);
+        for(int p = 0; p < n_points; ++p)
+        {
+            ofp << ys[p] << endl;
+        }
+        cout << "Written " << n_points << " values in " << ofilename << endl;
+    }
+
+    poly_batch_free(batch);
+    delete[] xs;
+    delete[] ys;
+    return 0;
+}
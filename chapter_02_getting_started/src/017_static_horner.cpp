@@ -0,0 +1,383 @@
+/**
+  Horner's rule and Estrin's scheme for polynomials known at compile time.
+
+  horners_rule (010_horners_rule) reads the coefficients from memory and
+  loops over them. When the polynomial is a fixed approximation, the
+  coefficients can be compile time constants instead. A coefficient set is a
+  type with static constexpr members len and coef[len] (from higher order to
+  lower order, as horners_rule takes them). static_horner<C>(x) and
+  static_estrin<C>(x) are unrolled by template recursion into straight line
+  code: a chain of multiply-adds with the coefficients as immediate
+  constants, or an Estrin tree of independent multiply-adds in x, x^2, x^4,
+  ... There are no loops, loads of coefficients or calls left after
+  inlining.
+
+  The value type is a template parameter too. With float or double the
+  functions are constexpr and can be evaluated by the compiler. With __m256
+  (AVX2) or __m512 (AVX-512) they evaluate 8 or 16 points at once and can be
+  used inside other vectorized kernels.
+
+  Compile with -O2 -march=native to enable AVX2/FMA.
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+//Coefficient type
+typedef float Dtype;
+
+
+/**
+  Example coefficient sets
+  */
+
+//exp(x) on [-0.5, 0.5]: Taylor series of degree 7
+struct ExpApprox
+{
+    static constexpr int len = 8;
+    static constexpr Dtype coef[len] = {1.0f / 5040, 1.0f / 720, 1.0f / 120,
+        1.0f / 24, 1.0f / 6, 1.0f / 2, 1.0f, 1.0f};
+};
+constexpr Dtype ExpApprox::coef[];
+
+//tanh(x) on [-1, 1]: odd polynomial of degree 9 (as a polynomial in x with
+//zero even coefficients)
+struct TanhApprox
+{
+    static constexpr int len = 10;
+    static constexpr Dtype coef[len] = {62.0f / 2835, 0.0f, -17.0f / 315,
+        0.0f, 2.0f / 15, 0.0f, -1.0f / 3, 0.0f, 1.0f, 0.0f};
+};
+constexpr Dtype TanhApprox::coef[];
+
+//A calibration curve of degree 15
+struct Calibration
+{
+    static constexpr int len = 16;
+    static constexpr Dtype coef[len] = {1e-7f, -2e-6f, 3e-6f, 1e-5f, -4e-5f,
+        2e-4f, -1e-3f, 3e-3f, -7e-3f, 0.011f, 0.021f, -0.042f, 0.13f, 0.71f,
+        1.02f, -0.003f};
+};
+constexpr Dtype Calibration::coef[];
+
+
+/**
+  Arithmetic used by the unrolled evaluators: splat<T>(c) converts a
+  coefficient to T, mul(a, b) = a * b and madd(a, b, c) = a * b + c.
+  */
+template <typename T>
+constexpr T splat(Dtype c)
+{
+    return T(c);
+}
+
+template <typename T>
+constexpr T mul(T a, T b)
+{
+    return a * b;
+}
+
+template <typename T>
+constexpr T madd(T a, T b, T c)
+{
+    return a * b + c;
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+template <>
+inline __m256 splat<__m256>(Dtype c)
+{
+    return _mm256_set1_ps(c);
+}
+
+template <>
+inline __m256 mul<__m256>(__m256 a, __m256 b)
+{
+    return _mm256_mul_ps(a, b);
+}
+
+template <>
+inline __m256 madd<__m256>(__m256 a, __m256 b, __m256 c)
+{
+    return _mm256_fmadd_ps(a, b, c);
+}
+#endif
+
+#if defined(__AVX512F__)
+template <>
+inline __m512 splat<__m512>(Dtype c)
+{
+    return _mm512_set1_ps(c);
+}
+
+template <>
+inline __m512 mul<__m512>(__m512 a, __m512 b)
+{
+    return _mm512_mul_ps(a, b);
+}
+
+template <>
+inline __m512 madd<__m512>(__m512 a, __m512 b, __m512 c)
+{
+    return _mm512_fmadd_ps(a, b, c);
+}
+#endif
+
+
+/**
+  Horner's rule up to coefficient I (from the higher order):
+  y_I = y_{I-1} * x + coef[I]
+  */
+template <typename C, int I>
+struct HornerStep
+{
+    template <typename T>
+    static constexpr T eval(T x)
+    {
+        return madd(HornerStep<C, I - 1>::eval(x), x, splat<T>(C::coef[I]));
+    }
+};
+
+template <typename C>
+struct HornerStep<C, 0>
+{
+    template <typename T>
+    static constexpr T eval(T)
+    {
+        return splat<T>(C::coef[0]);
+    }
+};
+
+
+/**
+  Value of the polynomial C at x by Horner's rule
+  */
+template <typename C, typename T>
+inline constexpr T static_horner(T x)
+{
+    return HornerStep<C, C::len - 1>::eval(x);
+}
+
+
+/**
+  x^N by repeated squaring (N a power of 2)
+  */
+template <int N>
+struct Power
+{
+    template <typename T>
+    static constexpr T eval(T x)
+    {
+        return mul(Power<N / 2>::eval(x), Power<N / 2>::eval(x));
+    }
+};
+
+template <>
+struct Power<1>
+{
+    template <typename T>
+    static constexpr T eval(T x)
+    {
+        return x;
+    }
+};
+
+
+/**
+  Largest power of 2 less than n (n >= 2)
+  */
+constexpr int estrin_split(int n, int m = 1)
+{
+    return (2 * m >= n) ? m : estrin_split(n, 2 * m);
+}
+
+
+/**
+  Estrin's scheme on the N coefficients of C from order B upwards:
+  E(B, N) = E(B, M) + x^M E(B + M, N - M), with M the largest power of 2
+  below N. Both halves are independent, and the powers of x are shared
+  after inlining.
+  */
+template <typename C, int B, int N>
+struct EstrinStep
+{
+    static const int M = estrin_split(N);
+
+    template <typename T>
+    static constexpr T eval(T x)
+    {
+        return madd(EstrinStep<C, B + M, N - M>::eval(x), Power<M>::eval(x),
+                EstrinStep<C, B, M>::eval(x));
+    }
+};
+
+template <typename C, int B>
+struct EstrinStep<C, B, 1>
+{
+    template <typename T>
+    static constexpr T eval(T)
+    {
+        //Coefficient of x^B
+        return splat<T>(C::coef[C::len - 1 - B]);
+    }
+};
+
+
+/**
+  Value of the polynomial C at x by Estrin's scheme
+  */
+template <typename C, typename T>
+inline constexpr T static_estrin(T x)
+{
+    return EstrinStep<C, 0, C::len>::eval(x);
+}
+
+
+//Evaluation at compile time
+static_assert(static_horner<ExpApprox>(0.0f) == 1.0f, "exp(0) must be 1");
+static_assert(static_estrin<TanhApprox>(0.0f) == 0.0f, "tanh(0) must be 0");
+
+
+/**
+  Horner's rule with the coefficients in memory (as in 010_horners_rule)
+  */
+Dtype horners_rule(const Dtype *array, int array_len, Dtype x)
+{
+    Dtype y = 0;
+    for(int i = 0; i < array_len; ++i)
+    {
+        y = array[i] + x * y;
+    }
+    return y;
+}
+
+
+/**
+  Evaluate C at all the points with the given method. An example of a
+  vectorized kernel with the polynomial inlined.
+  */
+enum METHOD {HORNER_MEMORY, HORNER_STATIC, ESTRIN_STATIC};
+
+template <typename C>
+void evaluate_points(const Dtype *xs, Dtype *ys, int n_points, METHOD method)
+{
+    int i = 0;
+    if(method == HORNER_MEMORY)
+    {
+        for(; i < n_points; ++i)
+        {
+            ys[i] = horners_rule(C::coef, C::len, xs[i]);
+        }
+        return;
+    }
+#if defined(__AVX2__) && defined(__FMA__)
+    for(; i + 8 <= n_points; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 y = (method == HORNER_STATIC) ? static_horner<C>(x) :
+            static_estrin<C>(x);
+        _mm256_storeu_ps(ys + i, y);
+    }
+#endif
+    for(; i < n_points; ++i)
+    {
+        ys[i] = (method == HORNER_STATIC) ? static_horner<C>(xs[i]) :
+            static_estrin<C>(xs[i]);
+    }
+}
+
+
+/**
+  Time and compare the methods on C at n_points points in [-1, 1]
+  */
+template <typename C>
+void benchmark(const string name, const Dtype *xs, int n_points)
+{
+    const string names[] = {"Horner (memory)", "Horner (static)",
+        "Estrin (static)"};
+    Dtype *ys = new Dtype[n_points];
+    Dtype *ref = new Dtype[n_points];
+    evaluate_points<C>(xs, ref, n_points, HORNER_MEMORY);
+    cout << name << " (degree " << C::len - 1 << "):" << endl;
+    for(int m = HORNER_MEMORY; m <= ESTRIN_STATIC; ++m)
+    {
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        evaluate_points<C>(xs, ys, n_points, METHOD(m));
+        chrono::duration<double> time = chrono::steady_clock::now() - t0;
+        double max_err = 0;
+        for(int i = 0; i < n_points; ++i)
+        {
+            max_err = fmax(max_err, fabs(ys[i] - ref[i]));
+        }
+        cout << "  " << names[m] << ": " << time.count() / n_points * 1e9 <<
+            " ns per point, maximum difference " << max_err << endl;
+    }
+    delete[] ys;
+    delete[] ref;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Compile time polynomials. Usage:\n\n";
+    cout << "1. " << command << "\n   Reads x from terminal and prints the"\
+        " example polynomials at x.\n\n";
+    cout << "2. " << command << " -b <number of points>\n   Compares the"\
+        " evaluators at random points in [-1, 1].\n";
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc == 3 && string(argv[1]) == "-b")
+    {
+        int n_points = atoi(argv[2]);
+        if(n_points <= 0)
+        {
+            usage(string(argv[0]));
+            return 0;
+        }
+        Dtype *xs = new Dtype[n_points];
+        for(int i = 0; i < n_points; ++i)
+        {
+            xs[i] = Dtype(rand()) / RAND_MAX * 2 - 1;
+        }
+        benchmark<ExpApprox>("exp", xs, n_points);
+        benchmark<TanhApprox>("tanh", xs, n_points);
+        benchmark<Calibration>("calibration", xs, n_points);
+        delete[] xs;
+        return 0;
+    }
+    if(argc != 1)
+    {
+        usage(string(argv[0]));
+        return 0;
+    }
+
+    Dtype x;
+    cout << "Enter value at which polynomials to be evaluated: ";
+    cin >> x;
+    cout << "exp(x) ~ " << static_horner<ExpApprox>(x) << " (Horner), " <<
+        static_estrin<ExpApprox>(x) << " (Estrin), " << exp(x) << endl;
+    cout << "tanh(x) ~ " << static_horner<TanhApprox>(x) << " (Horner), " <<
+        static_estrin<TanhApprox>(x) << " (Estrin), " << tanh(x) << endl;
+    cout << "calibration(x) = " << static_horner<Calibration>(x) <<
+        " (Horner), " << static_estrin<Calibration>(x) << " (Estrin)" << endl;
+    return 0;
+}
@@ -0,0 +1,677 @@
+/**
+  Rolling polynomial hash (Rabin-Karp) of every window of a stream.
+
+  The hash of the window s[i .. i + w - 1] is the polynomial with the window
+  as coefficients, evaluated at the base B by Horner's rule:
+  H_i = s[i] B^(w-1) + s[i+1] B^(w-2) + ... + s[i+w-1]  (mod p)
+  The next window is found in O(1), independent of w:
+  H_{i+1} = H_i B - s[i] B^w + s[i+w]
+  The modulus is the Mersenne prime p = 2^61 - 1, so that a product is
+  reduced with a shift, a mask and an add instead of a division. B is below
+  2^32, and for byte streams the term -c B^w is looked up in a table of 256
+  entries, so a step is one multiplication, one lookup and a few adds.
+  Between steps the hash is kept partially reduced (below 2^63) and is fully
+  reduced only when it is written out.
+
+  Each step depends on the previous one, so one stream is limited by the
+  latency of the multiplication. Many streams are hashed at once by keeping
+  one stream in each 64 bit lane of two AVX2 registers. AVX2 has only
+  32 x 32 bit multiplies, so H B is built from the two 32 bit halves of H,
+  which works because B < 2^32. A single long stream is hashed the same way
+  after splitting it into overlapping segments.
+
+  On top of the hash:
+  - rabin_karp_search finds all the occurrences of a pattern. Windows whose
+    hash matches the hash of the pattern are compared byte by byte.
+  - fingerprint_chunks splits data into content defined chunks (a chunk ends
+    where the window hash has its low mask_bits bits set) and fingerprints
+    each chunk. Equal content gives equal chunks even after insertions
+    elsewhere, so repeated chunks can be deduplicated by fingerprint.
+  To hash a stream block by block, overlap consecutive blocks by w - 1
+  elements.
+
+  Compile with -O2 -march=native to enable AVX2.
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+//Modulus p = 2^61 - 1
+const uint64_t MERSENNE_61 = (uint64_t(1) << 61) - 1;
+
+//Default base. The same base must be used for hashes which are compared.
+const uint64_t DEFAULT_BASE = 0x9E3779B1;
+
+//Default window length
+const int DEFAULT_WINDOW = 16;
+
+//Number of streams hashed together (2 AVX2 registers)
+const int STREAM_GROUP = 8;
+
+
+/**
+  Rolling hash of windows of length w. out_tab[c] = -c B^w mod p.
+  */
+struct RollingHash
+{
+    int w;
+    uint64_t base;
+    uint64_t base_w;
+    uint64_t out_tab[256];
+};
+
+
+/**
+  Full reduction of h < 2^64 modulo p
+  */
+inline uint64_t mod_reduce(uint64_t h)
+{
+    uint64_t r = (h & MERSENNE_61) + (h >> 61);
+    return (r >= MERSENNE_61) ? r - MERSENNE_61 : r;
+}
+
+
+/**
+  a b mod p for a, b < p
+  */
+inline uint64_t mul_mod(uint64_t a, uint64_t b)
+{
+    unsigned __int128 x = (unsigned __int128)a * b;
+    return mod_reduce(((uint64_t)x & MERSENNE_61) + (uint64_t)(x >> 61));
+}
+
+
+/**
+  h B, partially reduced, for h < 2^63 and B < 2^32. The result is below
+  2^61 + 2^34.
+  */
+inline uint64_t mul_base(uint64_t h, uint64_t base)
+{
+    unsigned __int128 x = (unsigned __int128)h * base;
+    return ((uint64_t)x & MERSENNE_61) + (uint64_t)(x >> 61);
+}
+
+
+/**
+  Initialize the rolling hash for windows of length w
+  */
+bool rolling_hash_init(RollingHash &rh, int w, uint64_t base = DEFAULT_BASE)
+{
+    if(w <= 0 || base < 256 || base >= (uint64_t(1) << 32))
+    {
+        cout << "Error: Window must be positive and base in [256, 2^32)\n";
+        return false;
+    }
+    rh.w = w;
+    rh.base = base;
+    rh.base_w = 1;
+    for(int i = 0; i < w; ++i) rh.base_w = mul_mod(rh.base_w, base);
+    for(int c = 0; c < 256; ++c)
+    {
+        uint64_t t = mul_mod(c, rh.base_w);
+        rh.out_tab[c] = (t == 0) ? 0 : MERSENNE_61 - t;
+    }
+    return true;
+}
+
+
+/**
+  -c B^w mod p for the element leaving the window. Bytes use the table.
+  */
+inline uint64_t roll_out(const RollingHash &rh, uint8_t c)
+{
+    return rh.out_tab[c];
+}
+
+inline uint64_t roll_out(const RollingHash &rh, uint32_t c)
+{
+    uint64_t t = mul_mod(c, rh.base_w);
+    return (t == 0) ? 0 : MERSENNE_61 - t;
+}
+
+
+/**
+  One step: the window loses out and gains in. h must be below 2^63, and so
+  is the result.
+  */
+template <typename T>
+inline uint64_t roll(const RollingHash &rh, uint64_t h, T out, T in)
+{
+    return mul_base(h, rh.base) + roll_out(rh, out) + in;
+}
+
+
+/**
+  Hash of the w elements at s, by Horner's rule (partially reduced)
+  */
+template <typename T>
+inline uint64_t hash_window(const RollingHash &rh, const T *s)
+{
+    uint64_t h = 0;
+    for(int i = 0; i < rh.w; ++i)
+    {
+        h = mul_base(h, rh.base) + s[i];
+    }
+    return h;
+}
+
+
+/**
+  Hashes of all the windows of s (length n). hashes[i] is the hash of
+  s[i .. i + w - 1]. Returns the number of windows, n - w + 1.
+  */
+template <typename T>
+size_t rolling_hash_all(const RollingHash &rh, const T *s, size_t n,
+        uint64_t *hashes)
+{
+    if(n < size_t(rh.w)) return 0;
+    uint64_t h = hash_window(rh, s);
+    hashes[0] = mod_reduce(h);
+    for(size_t i = rh.w; i < n; ++i)
+    {
+        h = roll(rh, h, s[i - rh.w], s[i]);
+        hashes[i - rh.w + 1] = mod_reduce(h);
+    }
+    return n - rh.w + 1;
+}
+
+
+#if defined(__AVX2__)
+/**
+  h B for 4 lanes, partially reduced, for h < 2^63 and B < 2^32:
+  h = hh 2^32 + hl, hl B is reduced as usual and, with hh B = t1 2^29 + t0,
+  hh B 2^32 = t1 2^61 + t0 2^32 = t1 + t0 2^32 (mod p).
+  */
+inline __m256i mul_base4(__m256i h, __m256i base)
+{
+    const __m256i p = _mm256_set1_epi64x(MERSENNE_61);
+    const __m256i mask29 = _mm256_set1_epi64x((1 << 29) - 1);
+    __m256i lo = _mm256_mul_epu32(h, base);
+    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(h, 32), base);
+    __m256i r = _mm256_add_epi64(_mm256_and_si256(lo, p),
+            _mm256_srli_epi64(lo, 61));
+    r = _mm256_add_epi64(r, _mm256_srli_epi64(hi, 29));
+    return _mm256_add_epi64(r, _mm256_slli_epi64(_mm256_and_si256(hi, mask29),
+                32));
+}
+
+
+/**
+  Full reduction of 4 lanes below 2^63
+  */
+inline __m256i mod_reduce4(__m256i h)
+{
+    const __m256i p = _mm256_set1_epi64x(MERSENNE_61);
+    __m256i r = _mm256_add_epi64(_mm256_and_si256(h, p),
+            _mm256_srli_epi64(h, 61));
+    __m256i ge = _mm256_cmpgt_epi64(r, _mm256_set1_epi64x(MERSENNE_61 - 1));
+    return _mm256_sub_epi64(r, _mm256_and_si256(ge, p));
+}
+#endif
+
+
+#if defined(__AVX2__)
+/**
+  Byte i of the 4 streams s[0..3], one in each lane
+  */
+inline __m256i load_lanes(const uint8_t * const *s, size_t i)
+{
+    return _mm256_set_epi64x(s[3][i], s[2][i], s[1][i], s[0][i]);
+}
+
+
+/**
+  One step of 4 lanes: h B - out B^w + in
+  */
+inline __m256i roll4(const RollingHash &rh, __m256i h, __m256i base,
+        __m256i out, __m256i in)
+{
+    __m256i t = _mm256_i64gather_epi64((const long long *)rh.out_tab, out, 8);
+    return _mm256_add_epi64(_mm256_add_epi64(mul_base4(h, base), t), in);
+}
+
+
+/**
+  Write the reduced hashes of 4 lanes at position i of their arrays
+  */
+inline void store_lanes(uint64_t * const *hashes, size_t i, __m256i h)
+{
+    alignas(32) uint64_t out[4];
+    _mm256_store_si256((__m256i *)out, mod_reduce4(h));
+    hashes[0][i] = out[0];
+    hashes[1][i] = out[1];
+    hashes[2][i] = out[2];
+    hashes[3][i] = out[3];
+}
+#endif
+
+
+/**
+  Hashes of all the windows of n_streams byte streams. Stream k has lens[k]
+  bytes and its hashes are written to hashes[k], as by rolling_hash_all.
+  With AVX2, groups of STREAM_GROUP streams are hashed together, one in each
+  lane of two registers (two independent chains), up to the length of the
+  shortest of them. The rest is hashed one stream at a time.
+  */
+void rolling_hash_streams(const RollingHash &rh, const uint8_t * const *streams,
+        const size_t *lens, uint64_t * const *hashes, int n_streams)
+{
+    int k = 0;
+#if defined(__AVX2__)
+    const size_t w = rh.w;
+    const __m256i base = _mm256_set1_epi64x(rh.base);
+    for(; k + STREAM_GROUP <= n_streams; k += STREAM_GROUP)
+    {
+        const uint8_t * const *s = streams + k;
+        uint64_t * const *out = hashes + k;
+        size_t m = lens[k];
+        for(int j = 1; j < STREAM_GROUP; ++j)
+        {
+            m = (lens[k + j] < m) ? lens[k + j] : m;
+        }
+        if(m < w)
+        {
+            for(int j = 0; j < STREAM_GROUP; ++j)
+            {
+                rolling_hash_all(rh, s[j], lens[k + j], out[j]);
+            }
+            continue;
+        }
+        __m256i h0 = _mm256_setzero_si256(), h1 = h0;
+        for(size_t i = 0; i < w; ++i)
+        {
+            h0 = _mm256_add_epi64(mul_base4(h0, base), load_lanes(s, i));
+            h1 = _mm256_add_epi64(mul_base4(h1, base), load_lanes(s + 4, i));
+        }
+        store_lanes(out, 0, h0);
+        store_lanes(out + 4, 0, h1);
+        for(size_t i = w; i < m; ++i)
+        {
+            h0 = roll4(rh, h0, base, load_lanes(s, i - w), load_lanes(s, i));
+            h1 = roll4(rh, h1, base, load_lanes(s + 4, i - w),
+                    load_lanes(s + 4, i));
+            store_lanes(out, i - w + 1, h0);
+            store_lanes(out + 4, i - w + 1, h1);
+        }
+        //Rest of the longer streams, from the state of their lanes
+        alignas(32) uint64_t state[STREAM_GROUP];
+        _mm256_store_si256((__m256i *)state, h0);
+        _mm256_store_si256((__m256i *)(state + 4), h1);
+        for(int j = 0; j < STREAM_GROUP; ++j)
+        {
+            uint64_t hj = state[j];
+            for(size_t i = m; i < lens[k + j]; ++i)
+            {
+                hj = roll(rh, hj, s[j][i - w], s[j][i]);
+                out[j][i - w + 1] = mod_reduce(hj);
+            }
+        }
+    }
+#endif
+    for(; k < n_streams; ++k)
+    {
+        rolling_hash_all(rh, streams[k], lens[k], hashes[k]);
+    }
+}
+
+
+/**
+  rolling_hash_all for one long byte stream. The stream is split into
+  STREAM_GROUP segments overlapping by w - 1 bytes, which are hashed
+  together by rolling_hash_streams.
+  */
+size_t rolling_hash_bytes(const RollingHash &rh, const uint8_t *s, size_t n,
+        uint64_t *hashes)
+{
+    const size_t w = rh.w;
+    if(n < w) return 0;
+    size_t n_windows = n - w + 1;
+    if(n_windows < size_t(STREAM_GROUP) * w)
+    {
+        return rolling_hash_all(rh, s, n, hashes);
+    }
+    //Segment j has the windows starting at j * part
+    size_t part = n_windows / STREAM_GROUP;
+    const uint8_t *streams[STREAM_GROUP];
+    size_t lens[STREAM_GROUP];
+    uint64_t *out[STREAM_GROUP];
+    for(int j = 0; j < STREAM_GROUP; ++j)
+    {
+        size_t n_seg = (j == STREAM_GROUP - 1) ? n_windows - j * part : part;
+        streams[j] = s + j * part;
+        lens[j] = n_seg + w - 1;
+        out[j] = hashes + j * part;
+    }
+    rolling_hash_streams(rh, streams, lens, out, STREAM_GROUP);
+    return n_windows;
+}
+
+
+/**
+  Positions of all the occurrences of pattern (length m) in text (length n).
+  Up to max_positions positions are written to positions. Returns the number
+  of occurrences.
+  */
+size_t rabin_karp_search(const uint8_t *text, size_t n, const uint8_t *pattern,
+        size_t m, size_t *positions, size_t max_positions)
+{
+    RollingHash rh;
+    if(m == 0 || m > n || !rolling_hash_init(rh, int(m))) return 0;
+    uint64_t target = mod_reduce(hash_window(rh, pattern));
+    uint64_t h = hash_window(rh, text);
+    size_t n_found = 0;
+    for(size_t i = 0;; ++i)
+    {
+        if(mod_reduce(h) == target)
+        {
+            //Verify, to rule out collisions
+            size_t j = 0;
+            while(j < m && text[i + j] == pattern[j]) ++j;
+            if(j == m)
+            {
+                if(n_found < max_positions) positions[n_found] = i;
+                ++n_found;
+            }
+        }
+        if(i + m >= n) break;
+        h = roll(rh, h, text[i], text[i + m]);
+    }
+    return n_found;
+}
+
+
+/**
+  A content defined chunk
+  */
+struct Chunk
+{
+    size_t offset;
+    size_t len;
+    uint64_t fingerprint;
+};
+
+
+/**
+  Split data (length n) into content defined chunks. A chunk ends after
+  byte i if the hash of the window ending at i has its low mask_bits bits
+  set, and the chunk has at least min_chunk bytes, or if the chunk has
+  max_chunk bytes. The fingerprint of a chunk is its polynomial hash (with
+  the bytes offset by 1, so that leading zero bytes count). chunks must have
+  room for n / min_chunk + 1 chunks. Returns the number of chunks.
+  */
+size_t fingerprint_chunks(const RollingHash &rh, const uint8_t *data,
+        size_t n, int mask_bits, size_t min_chunk, size_t max_chunk,
+        Chunk *chunks)
+{
+    const uint64_t mask = (uint64_t(1) << mask_bits) - 1;
+    const size_t w = rh.w;
+    if(min_chunk < 1) min_chunk = 1;
+    if(max_chunk < min_chunk) max_chunk = min_chunk;
+    size_t n_chunks = 0, beg = 0;
+    uint64_t h = 0, fp = 0;
+    for(size_t i = 0; i < n; ++i)
+    {
+        //Window hash: Horner's rule for the first window, then roll
+        h = (i < w) ? mul_base(h, rh.base) + data[i] :
+            roll(rh, h, data[i - w], data[i]);
+        fp = mul_base(fp, rh.base) + data[i] + 1;
+        size_t len = i + 1 - beg;
+        bool cut = (len >= max_chunk) || (len >= min_chunk && i + 1 >= w &&
+                (mod_reduce(h) & mask) == mask);
+        if(cut || i + 1 == n)
+        {
+            chunks[n_chunks].offset = beg;
+            chunks[n_chunks].len = len;
+            chunks[n_chunks].fingerprint = mod_reduce(fp);
+            ++n_chunks;
+            beg = i + 1;
+            fp = 0;
+        }
+    }
+    return n_chunks;
+}
+
+
+/**
+  Count of distinct fingerprints, with an open addressing hash set
+  */
+size_t count_distinct(const Chunk *chunks, size_t n_chunks,
+        size_t &distinct_bytes)
+{
+    size_t cap = 16;
+    while(cap < 2 * n_chunks) cap *= 2;
+    uint64_t *slots = new uint64_t[cap];
+    bool *used = new bool[cap]{};
+    size_t n_distinct = 0;
+    distinct_bytes = 0;
+    for(size_t c = 0; c < n_chunks; ++c)
+    {
+        uint64_t f = chunks[c].fingerprint;
+        size_t i = (f * 0x9E3779B97F4A7C15ULL) >> 20 & (cap - 1);
+        while(used[i] && slots[i] != f) i = (i + 1) & (cap - 1);
+        if(!used[i])
+        {
+            used[i] = true;
+            slots[i] = f;
+            ++n_distinct;
+            distinct_bytes += chunks[c].len;
+        }
+    }
+    delete[] slots;
+    delete[] used;
+    return n_distinct;
+}
+
+
+/**
+  Read a whole file as bytes
+  */
+bool read_bytes(const string filename, uint8_t **data, size_t &n)
+{
+    ifstream fp(filename, ios::binary | ios::ate);
+    if(!fp.is_open())
+    {
+        cout << "Error: Could not open " << filename << endl;
+        return false;
+    }
+    n = size_t(fp.tellg());
+    fp.seekg(0);
+    *data = new uint8_t[n > 0 ? n : 1];
+    fp.read((char *)*data, n);
+    cout << "Read " << n << " bytes." << endl;
+    return true;
+}
+
+
+/**
+  Hash all the windows of data, once as one stream and once split into
+  n_streams streams, and report the throughput
+  */
+void benchmark_hash(const uint8_t *data, size_t n, int w, int n_streams)
+{
+    RollingHash rh;
+    if(!rolling_hash_init(rh, w) || n < size_t(w)) return;
+    //Touched before timing, so that page faults are not counted
+    uint64_t *hashes = new uint64_t[n]{};
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    size_t n_windows = rolling_hash_all(rh, data, n, hashes);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    uint64_t check = 0;
+    for(size_t i = 0; i < n_windows; ++i) check ^= hashes[i];
+    cout << "One stream: " << n_windows << " windows of " << w <<
+        " bytes in " << time.count() * 1000 << " ms (" << n / time.count() *
+        1e-9 << " GB/s). Checksum " << check << endl;
+    t0 = chrono::steady_clock::now();
+    rolling_hash_bytes(rh, data, n, hashes);
+    time = chrono::steady_clock::now() - t0;
+    uint64_t check_segments = 0;
+    for(size_t i = 0; i < n_windows; ++i) check_segments ^= hashes[i];
+    cout << "One stream in " << STREAM_GROUP << " segments: " <<
+        time.count() * 1000 << " ms (" << n / time.count() * 1e-9 <<
+        " GB/s). Checksum " << check_segments << endl;
+
+    if(n_streams < 1) return;
+    //Equal parts, each hashed independently
+    const uint8_t **streams = new const uint8_t*[n_streams];
+    size_t *lens = new size_t[n_streams];
+    uint64_t **out = new uint64_t*[n_streams];
+    uint64_t *out_scalar = new uint64_t[n]{};
+    size_t part = n / n_streams;
+    for(int k = 0; k < n_streams; ++k)
+    {
+        streams[k] = data + k * part;
+        lens[k] = (k == n_streams - 1) ? n - k * part : part;
+        out[k] = hashes + k * part;
+    }
+    t0 = chrono::steady_clock::now();
+    rolling_hash_streams(rh, streams, lens, out, n_streams);
+    time = chrono::steady_clock::now() - t0;
+    cout << n_streams << " streams: " << time.count() * 1000 << " ms (" <<
+        n / time.count() * 1e-9 << " GB/s)";
+    size_t n_wrong = 0;
+    for(int k = 0; k < n_streams; ++k)
+    {
+        size_t nk = rolling_hash_all(rh, streams[k], lens[k], out_scalar);
+        for(size_t i = 0; i < nk; ++i) n_wrong += (out_scalar[i] != out[k][i]);
+    }
+    cout << ". Mismatches with one stream at a time: " << n_wrong << endl;
+    delete[] streams;
+    delete[] lens;
+    delete[] out;
+    delete[] out_scalar;
+    delete[] hashes;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Rolling hash. Usage:\n\n";
+    cout << "1. " << command << "\n   Reads a text and a pattern from terminal"\
+        " and finds the pattern.\n\n";
+    cout << "2. " << command << " -i <file> -w <window> -l <streams>\n   Hashes"\
+        " all the windows of the file and reports the throughput, also with"\
+        " the file split into that many streams.\n\n";
+    cout << "3. " << command << " -i <file> -p <pattern>\n   Finds the"\
+        " pattern in the file.\n\n";
+    cout << "4. " << command << " -i <file> -d <mask bits>\n   Splits the file"\
+        " into content defined chunks (average size about 2^mask_bits) and"\
+        " reports duplicate chunks.\n";
+}
+
+
+/**
+  Find the pattern and print the positions
+  */
+void search_and_print(const uint8_t *text, size_t n, const string pattern)
+{
+    const size_t max_print = 20;
+    size_t positions[max_print];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    size_t n_found = rabin_karp_search(text, n,
+            (const uint8_t *)pattern.data(), pattern.size(), positions,
+            max_print);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << "Found " << n_found << " occurrences in " << time.count() * 1000
+        << " ms.";
+    for(size_t i = 0; i < n_found && i < max_print; ++i)
+    {
+        cout << " " << positions[i];
+    }
+    cout << (n_found > max_print ? " ..." : "") << endl;
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc == 1)
+    {
+        string text, pattern;
+        cout << "Enter the text: ";
+        getline(cin, text);
+        cout << "Enter the pattern: ";
+        getline(cin, pattern);
+        search_and_print((const uint8_t *)text.data(), text.size(), pattern);
+        return 0;
+    }
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return 0;
+    }
+    string ifilename = "", pattern = "";
+    int w = DEFAULT_WINDOW, n_streams = 0, mask_bits = 0;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return 0;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input") ifilename = argv[i + 1];
+        if(arg_opt == "-w" || arg_opt == "--window") w = atoi(argv[i + 1]);
+        if(arg_opt == "-l" || arg_opt == "--streams")
+        {
+            n_streams = atoi(argv[i + 1]);
+        }
+        if(arg_opt == "-p" || arg_opt == "--pattern") pattern = argv[i + 1];
+        if(arg_opt == "-d" || arg_opt == "--dedup")
+        {
+            mask_bits = atoi(argv[i + 1]);
+        }
+    }
+
+    uint8_t *data = nullptr;
+    size_t n = 0;
+    if(!read_bytes(ifilename, &data, n))
+    {
+        return 0;
+    }
+    if(!pattern.empty())
+    {
+        search_and_print(data, n, pattern);
+    }
+    else if(mask_bits > 0 && mask_bits < 40)
+    {
+        RollingHash rh;
+        rolling_hash_init(rh, 48);
+        size_t min_chunk = (size_t(1) << mask_bits) / 4;
+        size_t max_chunk = (size_t(1) << mask_bits) * 4;
+        if(min_chunk < 1) min_chunk = 1;
+        Chunk *chunks = new Chunk[n / min_chunk + 1];
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        size_t n_chunks = fingerprint_chunks(rh, data, n, mask_bits, min_chunk,
+                max_chunk, chunks);
+        chrono::duration<double> time = chrono::steady_clock::now() - t0;
+        size_t distinct_bytes;
+        size_t n_distinct = count_distinct(chunks, n_chunks, distinct_bytes);
+        cout << n_chunks << " chunks (" << n_distinct << " distinct) in " <<
+            time.count() * 1000 << " ms (" << n / time.count() * 1e-9 <<
+            " GB/s). Distinct bytes: " << distinct_bytes << " of " << n <<
+            endl;
+        delete[] chunks;
+    }
+    else
+    {
+        benchmark_hash(data, n, w, n_streams);
+    }
+    delete[] data;
+    return 0;
+}
@@ -1,8 +1,21 @@
 /**
   Find maximum subarray by divide and conquer approach.
 
+  find_max_subarray finds the subarray crossing the mid point by scanning
+  both halves, so every level of the recursion costs n.
+
   Complexity: n log n
 
+  find_max_subarray_summary keeps the same recursion, but each call returns
+  a summary of its half: total, best prefix, best suffix and best subarray.
+  The crossing subarray is then the left suffix plus the right prefix, and
+  the summary of the whole is combined from the two in O(1). Halves shorter
+  than LEAF_LEN are summarized in one pass. While threads are left, the
+  left half of a piece of at least FORK_MIN_LEN runs in a new thread with
+  half of them, and the right half in the current one with the rest.
+
+  Complexity: n
+
 Author: Sandeep Palakkal
 Email: sandeep.dion@gmail.com
 Created on: 20-Aug-2016
@@ -13,13 +26,19 @@ Created on: 20-Aug-2016
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
-#include <ctime>
+#include <chrono>
+#include <thread>
 
 using namespace std;
 
 typedef float Dtype;
 enum SORT_TYPE {ASCEND, DESCEND, INVALID};
 
+//Pieces shorter than this are summarized without recursion, and pieces
+//shorter than this are not split across threads
+const int LEAF_LEN = 64;
+const int FORK_MIN_LEN = 1 << 16;
+
 
 /**
   Find the maximum subarray crossing the mid point given
@@ -131,6 +150,170 @@ void find_max_subarray(const Dtype *array, const int array_len, int &beg,
 }
 
 
+/**
+  Summary of the nonempty subarrays of a piece of the array. Ranges are
+  [beg, end) in indices of the whole array.
+  */
+struct SubarraySummary
+{
+    Dtype total;
+    Dtype prefix;
+    int prefix_end;
+    Dtype suffix;
+    int suffix_beg;
+    Dtype best;
+    int best_beg;
+    int best_end;
+};
+
+
+/**
+  Summary of array[left .. right - 1] (nonempty) in one pass. The best
+  suffix is found from the smallest prefix sum.
+  */
+void summarize_leaf(const Dtype *array, const int left, const int right,
+        SubarraySummary &s)
+{
+    s.total = array[left];
+    s.prefix = s.best = array[left];
+    s.prefix_end = left + 1;
+    s.best_beg = left;
+    s.best_end = left + 1;
+    //Smallest sum of array[left .. j - 1], over left <= j < right
+    Dtype min_head = 0;
+    int min_head_end = left;
+    Dtype sum_so_far = array[left];
+    int beg = left;
+    for(int i = left + 1; i < right; ++i)
+    {
+        if(s.total < min_head)
+        {
+            min_head = s.total;
+            min_head_end = i;
+        }
+        s.total += array[i];
+        if(s.total > s.prefix)
+        {
+            s.prefix = s.total;
+            s.prefix_end = i + 1;
+        }
+        if(sum_so_far < 0)
+        {
+            sum_so_far = 0;
+            beg = i;
+        }
+        sum_so_far += array[i];
+        if(sum_so_far > s.best)
+        {
+            s.best = sum_so_far;
+            s.best_beg = beg;
+            s.best_end = i + 1;
+        }
+    }
+    s.suffix = s.total - min_head;
+    s.suffix_beg = min_head_end;
+}
+
+
+/**
+  Summary of the concatenation of the pieces summarized by l and r
+  */
+SubarraySummary combine_summaries(const SubarraySummary &l,
+        const SubarraySummary &r)
+{
+    SubarraySummary s;
+    s.total = l.total + r.total;
+    s.prefix = l.prefix;
+    s.prefix_end = l.prefix_end;
+    if(l.total + r.prefix > s.prefix)
+    {
+        s.prefix = l.total + r.prefix;
+        s.prefix_end = r.prefix_end;
+    }
+    s.suffix = r.suffix;
+    s.suffix_beg = r.suffix_beg;
+    if(l.suffix + r.total > s.suffix)
+    {
+        s.suffix = l.suffix + r.total;
+        s.suffix_beg = l.suffix_beg;
+    }
+    //The subarray crossing the mid point
+    s.best = l.best;
+    s.best_beg = l.best_beg;
+    s.best_end = l.best_end;
+    if(l.suffix + r.prefix > s.best)
+    {
+        s.best = l.suffix + r.prefix;
+        s.best_beg = l.suffix_beg;
+        s.best_end = r.prefix_end;
+    }
+    if(r.best > s.best)
+    {
+        s.best = r.best;
+        s.best_beg = r.best_beg;
+        s.best_end = r.best_end;
+    }
+    return s;
+}
+
+
+/**
+  Summary of array[left .. right - 1] with n_threads threads
+  */
+SubarraySummary summarize_subarray(const Dtype *array, const int left,
+        const int right, const int n_threads)
+{
+    SubarraySummary s;
+    if(right - left < LEAF_LEN)
+    {
+        summarize_leaf(array, left, right, s);
+        return s;
+    }
+
+    int mid = left + (right - left) / 2;
+    SubarraySummary left_s, right_s;
+    if(n_threads > 1 && right - left >= FORK_MIN_LEN)
+    {
+        int left_threads = n_threads / 2;
+        thread left_thread([&]()
+        {
+            left_s = summarize_subarray(array, left, mid, left_threads);
+        });
+        right_s = summarize_subarray(array, mid, right,
+                n_threads - left_threads);
+        left_thread.join();
+    }
+    else
+    {
+        left_s = summarize_subarray(array, left, mid, 1);
+        right_s = summarize_subarray(array, mid, right, 1);
+    }
+    return combine_summaries(left_s, right_s);
+}
+
+
+/**
+  Find the maximum subarray in O(n) with n_threads threads: wrapper code
+  */
+void find_max_subarray_summary(const Dtype *array, const int array_len,
+        int &beg, int &end, Dtype &sum, const int n_threads)
+{
+    if(array_len > 0)
+    {
+        SubarraySummary s = summarize_subarray(array, 0, array_len,
+                n_threads);
+        beg = s.best_beg;
+        end = s.best_end;
+        sum = s.best;
+    }
+    else
+    {
+        beg = end = 0;
+        sum = 0;
+    }
+}
+
+
 /**
   Read array from terminal
   */
@@ -206,10 +389,13 @@ void usage(const string command)
     cout << "Find maximum subarray. Usage:\n\n";
     cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
         " terminal.\n\n";
-    cout << "2. " << command << " -i <input file>" << endl;
+    cout << "2. " << command << " -i <input file> -m <method>"\
+        " -t <number of threads>" << endl;
         
     cout << "   Reads input array from input file. First element in the file"\
-        " must be the length of the array.\n";
+        " must be the length of the array. Method 1 is the n log n"\
+        " recursion and method 2 (default) the O(n) recursion on summaries,"\
+        " which uses all the cores by default.\n";
 }
 
 
@@ -217,7 +403,7 @@ void usage(const string command)
   Parse and get all inputs
   */
 bool parse_and_get_inputs(const int argc, char **argv, Dtype **array, 
-        int &array_len)
+        int &array_len, int &method, int &n_threads)
 {
     if(argc % 2 == 0)
     {
@@ -240,6 +426,20 @@ bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
                 return false;
             }
         }
+        if(arg_opt == "-m" || arg_opt == "--method")
+        {
+            method = atoi(argv[i + 1]);
+        }
+        if(arg_opt == "-t" || arg_opt == "--threads")
+        {
+            n_threads = atoi(argv[i + 1]);
+        }
+    }
+    if(method != 1 && method != 2)
+    {
+        cout << "Error: Method must be 1 or 2\n";
+        if(*array != nullptr) delete[] *array;
+        return false;
     }
     if(*array == nullptr)
     {
@@ -255,9 +455,12 @@ int main(int argc, char **argv)
 {
     Dtype *array = nullptr;
     int array_len = 0;
+    int method = 2;
+    int n_threads = thread::hardware_concurrency();
     
     //Parse and get inputs
-    if(!parse_and_get_inputs(argc, argv, &array, array_len))
+    if(!parse_and_get_inputs(argc, argv, &array, array_len, method,
+                n_threads))
     {
         return 0;
     }
@@ -265,11 +468,18 @@ int main(int argc, char **argv)
     //Find max subarray
     int beg, end;
     Dtype sum;
-    clock_t t0 = clock();
-    find_max_subarray(array, array_len, beg, end, sum);
-    t0 = clock() - t0;
-    cout << "Time taken to find the subarray: " 
-        << float(t0)/CLOCKS_PER_SEC * 1000 << " ms.\n";
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    if(method == 1)
+    {
+        find_max_subarray(array, array_len, beg, end, sum);
+    }
+    else
+    {
+        find_max_subarray_summary(array, array_len, beg, end, sum, n_threads);
+    }
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << "Time taken to find the subarray: " << time.count() * 1000 <<
+        " ms.\n";
 
     //Print result
     if(end > beg)
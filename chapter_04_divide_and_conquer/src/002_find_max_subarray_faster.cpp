@@ -15,6 +15,23 @@
 
   This is called Kadane's algorithm.
 
+  The scan is serial, but maximum subarrays of adjacent pieces combine
+  associatively if each piece is summarized by its total, its best prefix,
+  its best suffix and its best subarray:
+  total  = total_L + total_R
+  prefix = max(prefix_L, total_L + prefix_R)
+  suffix = max(suffix_R, suffix_L + total_R)
+  best   = max(best_L, best_R, suffix_L + prefix_R)
+  The parallel version splits the array into one chunk per thread,
+  summarizes the chunks in parallel with one pass each and combines the
+  summaries from left to right.
+
+  Kadane's algorithm needs only the running state (best sum and range, sum
+  so far and where it starts), so it can also run on a stream of unknown
+  length. The streaming mode reads values in chunks of STREAM_CHUNK from a
+  file or the standard input, keeps the state with 64 bit indices and
+  reports the best subarray so far at regular intervals.
+
   Complexity: n
 
 Author: Sandeep Palakkal
@@ -26,14 +43,57 @@ Created on: 21-Aug-2016
 #include <string>
 #include <cstddef>
 #include <cstdlib>
+#include <cstdint>
 #include <fstream>
-#include <ctime>
+#include <chrono>
+#include <thread>
 
 using namespace std;
 
 typedef float Dtype;
 enum SORT_TYPE {ASCEND, DESCEND, INVALID};
 
+//Below this length the parallel version runs serially
+const int PARALLEL_MIN_LEN = 1 << 16;
+
+//Number of values read at a time in streaming mode, and the default
+//number of values between reports
+const int STREAM_CHUNK = 4096;
+const int64_t DEFAULT_REPORT_EVERY = 1000000;
+
+
+/**
+  Summary of the nonempty subarrays of a piece of the array. Ranges are
+  [beg, end) in indices of the whole array.
+  */
+struct SubarraySummary
+{
+    Dtype total;
+    Dtype prefix;
+    int prefix_end;
+    Dtype suffix;
+    int suffix_beg;
+    Dtype best;
+    int best_beg;
+    int best_end;
+};
+
+
+/**
+  State of Kadane's algorithm on a stream. count values have been seen and
+  the best subarray so far is [beg, end) with sum sum. The sum of the
+  values from left up to the last one is sum_so_far.
+  */
+struct KadaneState
+{
+    int64_t count;
+    Dtype sum;
+    int64_t beg;
+    int64_t end;
+    Dtype sum_so_far;
+    int64_t left;
+};
+
 
 /**
   Find the maximum subarray faster algorithm.
@@ -80,6 +140,236 @@ void find_max_subarray_faster(const Dtype *array, int array_len,
 }
 
 
+/**
+  Summary of array[beg .. end - 1] (nonempty) in one pass. The best
+  subarray is found as in find_max_subarray_faster and the best suffix from
+  the smallest prefix sum.
+  */
+void summarize_subarrays(const Dtype *array, int beg, int end,
+        SubarraySummary &s)
+{
+    s.total = array[beg];
+    s.prefix = s.best = array[beg];
+    s.prefix_end = beg + 1;
+    s.best_beg = beg;
+    s.best_end = beg + 1;
+    //Smallest sum of array[beg .. j - 1], over beg <= j < end
+    Dtype min_head = 0;
+    int min_head_end = beg;
+    Dtype sum_so_far = (array[beg] < 0) ? 0 : array[beg];
+    int left = (array[beg] < 0) ? beg + 1 : beg;
+    for(int i = beg + 1; i < end; ++i)
+    {
+        if(s.total < min_head)
+        {
+            min_head = s.total;
+            min_head_end = i;
+        }
+        s.total += array[i];
+        if(s.total > s.prefix)
+        {
+            s.prefix = s.total;
+            s.prefix_end = i + 1;
+        }
+        Dtype sum_here = sum_so_far + array[i];
+        if(sum_here > s.best)
+        {
+            s.best = sum_here;
+            s.best_beg = left;
+            s.best_end = i + 1;
+        }
+        if(sum_here < 0)
+        {
+            sum_so_far = 0;
+            left = i + 1;
+        }
+        else sum_so_far = sum_here;
+    }
+    s.suffix = s.total - min_head;
+    s.suffix_beg = min_head_end;
+}
+
+
+/**
+  Summary of the concatenation of the pieces summarized by l and r
+  */
+SubarraySummary combine_summaries(const SubarraySummary &l,
+        const SubarraySummary &r)
+{
+    SubarraySummary s;
+    s.total = l.total + r.total;
+    s.prefix = l.prefix;
+    s.prefix_end = l.prefix_end;
+    if(l.total + r.prefix > s.prefix)
+    {
+        s.prefix = l.total + r.prefix;
+        s.prefix_end = r.prefix_end;
+    }
+    s.suffix = r.suffix;
+    s.suffix_beg = r.suffix_beg;
+    if(l.suffix + r.total > s.suffix)
+    {
+        s.suffix = l.suffix + r.total;
+        s.suffix_beg = l.suffix_beg;
+    }
+    s.best = l.best;
+    s.best_beg = l.best_beg;
+    s.best_end = l.best_end;
+    if(l.suffix + r.prefix > s.best)
+    {
+        s.best = l.suffix + r.prefix;
+        s.best_beg = l.suffix_beg;
+        s.best_end = r.prefix_end;
+    }
+    if(r.best > s.best)
+    {
+        s.best = r.best;
+        s.best_beg = r.best_beg;
+        s.best_end = r.best_end;
+    }
+    return s;
+}
+
+
+/**
+  Find the maximum subarray with n_threads threads. The result is the same
+  (beg, end, sum) as find_max_subarray_faster, up to the rounding of float
+  sums in a different order and the choice among equal sums.
+  */
+void find_max_subarray_parallel(const Dtype *array, int array_len,
+        int &beg, int &end, Dtype &sum, int n_threads)
+{
+    if(n_threads <= 1 || array_len < PARALLEL_MIN_LEN)
+    {
+        find_max_subarray_faster(array, array_len, beg, end, sum);
+        return;
+    }
+    int chunk = (array_len + n_threads - 1) / n_threads;
+    n_threads = (array_len + chunk - 1) / chunk;
+    SubarraySummary *summaries = new SubarraySummary[n_threads];
+    thread *threads = new thread[n_threads];
+    for(int t = 0; t < n_threads; ++t)
+    {
+        int lo = t * chunk;
+        int hi = (lo + chunk < array_len) ? lo + chunk : array_len;
+        threads[t] = thread([=]()
+        {
+            summarize_subarrays(array, lo, hi, summaries[t]);
+        });
+    }
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+    }
+    SubarraySummary s = summaries[0];
+    for(int t = 1; t < n_threads; ++t)
+    {
+        s = combine_summaries(s, summaries[t]);
+    }
+    beg = s.best_beg;
+    end = s.best_end;
+    sum = s.best;
+    delete[] threads;
+    delete[] summaries;
+}
+
+
+/**
+  Start a stream
+  */
+void kadane_stream_init(KadaneState &st)
+{
+    st.count = 0;
+    st.sum = 0;
+    st.beg = st.end = 0;
+    st.sum_so_far = 0;
+    st.left = 0;
+}
+
+
+/**
+  Continue the stream with n more values. The steps are those of
+  find_max_subarray_faster.
+  */
+void kadane_stream_update(KadaneState &st, const Dtype *values, int n)
+{
+    int i = 0;
+    if(st.count == 0 && n > 0)
+    {
+        st.sum = values[0];
+        st.beg = 0;
+        st.end = 1;
+        st.sum_so_far = (values[0] < 0) ? 0 : values[0];
+        st.left = (values[0] < 0) ? 1 : 0;
+        st.count = 1;
+        i = 1;
+    }
+    for(; i < n; ++i, ++st.count)
+    {
+        Dtype sum_here = st.sum_so_far + values[i];
+        if(sum_here > st.sum)
+        {
+            st.sum = sum_here;
+            st.beg = st.left;
+            st.end = st.count + 1;
+        }
+        if(sum_here < 0)
+        {
+            st.sum_so_far = 0;
+            st.left = st.count + 1;
+        }
+        else st.sum_so_far = sum_here;
+    }
+}
+
+
+/**
+  Print the best subarray so far
+  */
+void print_stream_state(const KadaneState &st)
+{
+    cout << "After " << st.count << " values: ";
+    if(st.end > st.beg)
+    {
+        cout << "maximum subarray sum " << st.sum << " at [" << st.beg + 1 <<
+            ", " << st.end << "]" << endl;
+    }
+    else
+    {
+        cout << "no values" << endl;
+    }
+}
+
+
+/**
+  Maximum subarray of the values read from in until the end of the input,
+  in chunks of STREAM_CHUNK values. Every report_every values (if positive)
+  the best subarray so far is printed.
+  */
+void find_max_subarray_stream(istream &in, int64_t report_every,
+        KadaneState &st)
+{
+    Dtype chunk[STREAM_CHUNK];
+    int64_t next_report = report_every;
+    kadane_stream_init(st);
+    while(in)
+    {
+        int n = 0;
+        while(n < STREAM_CHUNK && in >> chunk[n]) ++n;
+        kadane_stream_update(st, chunk, n);
+        if(report_every > 0 && st.count >= next_report)
+        {
+            print_stream_state(st);
+            while(next_report <= st.count) next_report += report_every;
+        }
+    }
+    if(!in.eof())
+    {
+        cout << "Warning: Stopped at a value that could not be read\n";
+    }
+}
+
+
 /**
   Read array from terminal
   */
@@ -155,10 +445,18 @@ void usage(const string command)
     cout << "Find maximum subarray. Usage:\n\n";
     cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
         " terminal.\n\n";
-    cout << "2. " << command << " -i <input file>" << endl;
+    cout << "2. " << command << " -i <input file> -t <number of threads>" <<
+        endl;
         
     cout << "   Reads input array from input file. First element in the file"\
-        " must be the length of the array.\n";
+        " must be the length of the array. By default, all the cores are"\
+        " used.\n\n";
+    cout << "3. " << command << " -s <input file | -> -r <report interval>" <<
+        endl;
+    cout << "   Streaming mode. Reads values (without the length) from the"\
+        " file, or from the standard input for -, until the end of the input."\
+        " The best subarray so far is printed every report interval values"\
+        " (default " << DEFAULT_REPORT_EVERY << ", 0 for none).\n";
 }
 
 
@@ -166,7 +464,8 @@ void usage(const string command)
   Parse and get all inputs
   */
 bool parse_and_get_inputs(const int argc, char **argv, Dtype **array, 
-        int &array_len)
+        int &array_len, int &n_threads, string &stream_name,
+        int64_t &report_every)
 {
     if(argc % 2 == 0)
     {
@@ -174,6 +473,7 @@ bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
         return false;
     }
     *array = nullptr;
+    string ifilename = "";
     for(int i = 1; i < argc; i += 2)
     {
         string arg_opt {argv[i]};
@@ -184,13 +484,34 @@ bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
         }
         if(arg_opt == "-i" || arg_opt == "--input")
         {
-            if(!read_array_file(string(argv[i + 1]), array, array_len))
-            {
-                return false;
-            }
+            ifilename = string(argv[i + 1]);
         }
+        if(arg_opt == "-t" || arg_opt == "--threads")
+        {
+            n_threads = atoi(argv[i + 1]);
+        }
+        if(arg_opt == "-s" || arg_opt == "--stream")
+        {
+            stream_name = string(argv[i + 1]);
+        }
+        if(arg_opt == "-r" || arg_opt == "--report")
+        {
+            report_every = atoll(argv[i + 1]);
+        }
+    }
+    //Streaming mode reads the input later
+    if(!stream_name.empty())
+    {
+        return true;
     }
-    if(*array == nullptr)
+    if(!ifilename.empty())
+    {
+        if(!read_array_file(ifilename, array, array_len))
+        {
+            return false;
+        }
+    }
+    else
     {
         if(!read_array_term(array, array_len))
         {
@@ -204,21 +525,53 @@ int main(int argc, char **argv)
 {
     Dtype *array = nullptr;
     int array_len = 0;
+    int n_threads = thread::hardware_concurrency();
+    string stream_name = "";
+    int64_t report_every = DEFAULT_REPORT_EVERY;
     
     //Parse and get inputs
-    if(!parse_and_get_inputs(argc, argv, &array, array_len))
+    if(!parse_and_get_inputs(argc, argv, &array, array_len, n_threads,
+                stream_name, report_every))
+    {
+        return 0;
+    }
+
+    //Streaming mode
+    if(!stream_name.empty())
     {
+        KadaneState st;
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        if(stream_name == "-")
+        {
+            //cin is buffered by itself only without the C stdio sync
+            ios_base::sync_with_stdio(false);
+            find_max_subarray_stream(cin, report_every, st);
+        }
+        else
+        {
+            ifstream fp {stream_name};
+            if(!fp.is_open())
+            {
+                cout << "Error: Input file could not be opened\n";
+                return 0;
+            }
+            find_max_subarray_stream(fp, report_every, st);
+        }
+        chrono::duration<double> time = chrono::steady_clock::now() - t0;
+        cout << fixed;
+        print_stream_state(st);
+        cout << "Time taken: " << time.count() * 1000 << " ms.\n";
         return 0;
     }
 
     //Find max subarray
     int beg, end;
     Dtype sum;
-    clock_t t0 = clock();
-    find_max_subarray_faster(array, array_len, beg, end, sum);
-    t0 = clock() - t0;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    find_max_subarray_parallel(array, array_len, beg, end, sum, n_threads);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
     cout << "Time taken to find the subarray: " 
-        << float(t0)/CLOCKS_PER_SEC * 1000 << " ms.\n";
+        << time.count() * 1000 << " ms.\n";
 
     //Print result
     if(end > beg)
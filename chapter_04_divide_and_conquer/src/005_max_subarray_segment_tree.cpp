@@ -0,0 +1,496 @@
+/**
+  Maximum subarray of any range of an array that changes, by a segment tree.
+
+  find_max_subarray divides the array at the middle and combines the halves:
+  the best subarray is in the left half, in the right half or crosses the
+  middle, in which case it is the best suffix of the left half followed by
+  the best prefix of the right half (find_max_subarray_crossing). If each
+  piece keeps its total, best prefix, best suffix and best subarray, the
+  combine is O(1):
+  total  = total_L + total_R
+  prefix = max(prefix_L, total_L + prefix_R)
+  suffix = max(suffix_R, suffix_L + total_R)
+  best   = max(best_L, best_R, suffix_L + prefix_R)
+  A segment tree keeps these summaries for the pieces of the recursion, so
+  that:
+  - a range [l, r) is covered by O(log n) pieces, which are combined from
+    left to right,
+  - changing a value changes only the O(log n) pieces above it.
+
+  The tree is stored implicitly in one array: node 1 is the root, the
+  children of node i are 2i and 2i + 1, and the leaves are the nodes
+  size .. 2 size - 1 (size is n rounded up to a power of 2). Queries and
+  updates walk up from the leaves, without recursion. The bulk build
+  summarizes the leaves and the subtrees below the top levels in parallel
+  (one contiguous subtree per thread), then the top levels. It is O(n).
+
+  Complexity: n for building, log n for an update or a query
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <chrono>
+#include <thread>
+
+using namespace std;
+
+typedef float Dtype;
+
+//Below this length the tree is built by one thread
+const int PARALLEL_MIN_LEN = 1 << 16;
+
+
+/**
+  Summary of a piece of the array. Ranges are [beg, end) in indices of the
+  array. An empty piece has len 0.
+  */
+struct SubarraySummary
+{
+    int len;
+    Dtype total;
+    Dtype prefix;
+    int prefix_end;
+    Dtype suffix;
+    int suffix_beg;
+    Dtype best;
+    int best_beg;
+    int best_end;
+};
+
+
+/**
+  Segment tree over array_len values. Node i is nodes[i].
+  */
+struct SegmentTree
+{
+    int array_len;
+    int size;
+    SubarraySummary *nodes;
+};
+
+
+/**
+  Summary of the single value at index i
+  */
+inline SubarraySummary leaf_summary(Dtype value, int i)
+{
+    SubarraySummary s;
+    s.len = 1;
+    s.total = s.prefix = s.suffix = s.best = value;
+    s.prefix_end = s.best_end = i + 1;
+    s.suffix_beg = s.best_beg = i;
+    return s;
+}
+
+
+/**
+  Summary of the concatenation of the pieces summarized by l and r. The
+  crossing candidate is the best suffix of l followed by the best prefix of
+  r, as in find_max_subarray_crossing.
+  */
+inline SubarraySummary combine_summaries(const SubarraySummary &l,
+        const SubarraySummary &r)
+{
+    if(l.len == 0) return r;
+    if(r.len == 0) return l;
+    SubarraySummary s;
+    s.len = l.len + r.len;
+    s.total = l.total + r.total;
+    s.prefix = l.prefix;
+    s.prefix_end = l.prefix_end;
+    if(l.total + r.prefix > s.prefix)
+    {
+        s.prefix = l.total + r.prefix;
+        s.prefix_end = r.prefix_end;
+    }
+    s.suffix = r.suffix;
+    s.suffix_beg = r.suffix_beg;
+    if(l.suffix + r.total > s.suffix)
+    {
+        s.suffix = l.suffix + r.total;
+        s.suffix_beg = l.suffix_beg;
+    }
+    s.best = l.best;
+    s.best_beg = l.best_beg;
+    s.best_end = l.best_end;
+    if(l.suffix + r.prefix > s.best)
+    {
+        s.best = l.suffix + r.prefix;
+        s.best_beg = l.suffix_beg;
+        s.best_end = r.prefix_end;
+    }
+    if(r.best > s.best)
+    {
+        s.best = r.best;
+        s.best_beg = r.best_beg;
+        s.best_end = r.best_end;
+    }
+    return s;
+}
+
+
+/**
+  Build the subtree of the nodes at level depth log2(size / n_leaves) that
+  covers the leaves [lo, lo + n_leaves). Leaves beyond the array are empty.
+  */
+void build_subtree(SegmentTree &tree, const Dtype *array, int lo,
+        int n_leaves)
+{
+    SubarraySummary *nodes = tree.nodes;
+    for(int i = lo; i < lo + n_leaves; ++i)
+    {
+        if(i < tree.array_len)
+        {
+            nodes[tree.size + i] = leaf_summary(array[i], i);
+        }
+        else
+        {
+            nodes[tree.size + i].len = 0;
+        }
+    }
+    //Nodes of each level above, from the bottom
+    for(int first = (tree.size + lo) / 2, count = n_leaves / 2; count > 0;
+            first /= 2, count /= 2)
+    {
+        for(int i = first; i < first + count; ++i)
+        {
+            nodes[i] = combine_summaries(nodes[2 * i], nodes[2 * i + 1]);
+        }
+    }
+}
+
+
+/**
+  Build the tree over array (array_len > 0) with n_threads threads
+  */
+bool segment_tree_build(SegmentTree &tree, const Dtype *array, int array_len,
+        int n_threads)
+{
+    if(array_len <= 0)
+    {
+        cout << "Error: The array is empty\n";
+        tree.nodes = nullptr;
+        return false;
+    }
+    tree.array_len = array_len;
+    tree.size = 1;
+    while(tree.size < array_len) tree.size *= 2;
+    tree.nodes = new SubarraySummary[2 * tree.size];
+    //One subtree per thread, for a power of 2 number of threads
+    int n_parts = 1;
+    if(array_len >= PARALLEL_MIN_LEN)
+    {
+        while(2 * n_parts <= n_threads && 2 * n_parts <= tree.size)
+        {
+            n_parts *= 2;
+        }
+    }
+    int part = tree.size / n_parts;
+    if(n_parts == 1)
+    {
+        build_subtree(tree, array, 0, part);
+    }
+    else
+    {
+        thread *threads = new thread[n_parts];
+        for(int t = 0; t < n_parts; ++t)
+        {
+            threads[t] = thread([&tree, array, t, part]()
+            {
+                build_subtree(tree, array, t * part, part);
+            });
+        }
+        for(int t = 0; t < n_parts; ++t)
+        {
+            threads[t].join();
+        }
+        delete[] threads;
+    }
+    //Top levels, above the roots of the subtrees
+    for(int i = n_parts - 1; i >= 1; --i)
+    {
+        tree.nodes[i] = combine_summaries(tree.nodes[2 * i],
+                tree.nodes[2 * i + 1]);
+    }
+    return true;
+}
+
+
+/**
+  Free the tree
+  */
+void segment_tree_free(SegmentTree &tree)
+{
+    delete[] tree.nodes;
+    tree.nodes = nullptr;
+}
+
+
+/**
+  Set array[i] = value
+  */
+void segment_tree_update(SegmentTree &tree, int i, Dtype value)
+{
+    int node = tree.size + i;
+    tree.nodes[node] = leaf_summary(value, i);
+    for(node /= 2; node >= 1; node /= 2)
+    {
+        tree.nodes[node] = combine_summaries(tree.nodes[2 * node],
+                tree.nodes[2 * node + 1]);
+    }
+}
+
+
+/**
+  Maximum subarray of array[l .. r - 1] (0 <= l < r <= array_len). The
+  pieces on the left are combined into left and those on the right into
+  right, keeping the order.
+  */
+void segment_tree_query(const SegmentTree &tree, int l, int r, int &beg,
+        int &end, Dtype &sum)
+{
+    SubarraySummary left, right;
+    left.len = right.len = 0;
+    for(l += tree.size, r += tree.size; l < r; l /= 2, r /= 2)
+    {
+        if(l & 1) left = combine_summaries(left, tree.nodes[l++]);
+        if(r & 1) right = combine_summaries(tree.nodes[--r], right);
+    }
+    SubarraySummary s = combine_summaries(left, right);
+    beg = s.best_beg;
+    end = s.best_end;
+    sum = s.best;
+}
+
+
+/**
+  Read array from terminal
+  */
+bool read_array_term(Dtype **array, int &array_len)
+{
+    cout << "Enter the length of the array: ";
+    cin >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    cout << "Enter the array elements: ";
+    for(int i = 0; i < array_len; ++i)
+    {
+        cin >> (*array)[i];
+    }
+   return true;
+}
+
+
+/**
+  Read array from file
+  */
+bool read_array_file(const string filename, Dtype **array, int &array_len)
+{
+    ifstream fp {filename};
+    cout << "Reading input file... ";
+    if(!fp.is_open())
+    {
+        cout << "Error: Input file could not be opened\n";
+        return false;
+    }
+    fp >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    for(int i = 0; i < array_len; ++i)
+    {
+        fp >> (*array)[i];
+    }
+    fp.close();
+    cout << "Read " << array_len << " elements." << endl;
+    return true;
+}
+
+
+/**
+  Run the operations read from in until the end of the input:
+  q l r  - maximum subarray of elements l to r (1 based, inclusive)
+  u i v  - set element i (1 based) to v
+  Results of queries are written to out.
+  */
+void run_operations(SegmentTree &tree, istream &in, ostream &out)
+{
+    char op;
+    int n_ops = 0;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    out << fixed;
+    while(in >> op)
+    {
+        if(op == 'q')
+        {
+            int l, r, beg, end;
+            Dtype sum;
+            in >> l >> r;
+            if(l < 1 || r > tree.array_len || l > r)
+            {
+                out << "Invalid range [" << l << ", " << r << "]" << endl;
+                continue;
+            }
+            segment_tree_query(tree, l - 1, r, beg, end, sum);
+            out << sum << " [" << beg + 1 << ", " << end << "]" << endl;
+        }
+        else if(op == 'u')
+        {
+            int i;
+            Dtype value;
+            in >> i >> value;
+            if(i < 1 || i > tree.array_len)
+            {
+                out << "Invalid index " << i << endl;
+                continue;
+            }
+            segment_tree_update(tree, i - 1, value);
+        }
+        else
+        {
+            break;
+        }
+        ++n_ops;
+    }
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << n_ops << " operations took " << time.count() * 1000 << " ms."
+        << endl;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Maximum subarray of ranges with updates. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -i <input file> -q <operations file> -o"\
+        " <output file> -t <number of threads>" << endl;
+    cout << "   First element in the input file must be the length of the"\
+        " array. Each operation is \"q l r\" (maximum subarray of elements l"\
+        " to r, 1 based and inclusive) or \"u i v\" (set element i to v)."\
+        " Operations are read from terminal if no file is given, and query"\
+        " results are written to terminal if no output file is given.\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
+        int &array_len, string &qfilename, string &ofilename, int &n_threads)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    *array = nullptr;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input")
+        {
+            if(!read_array_file(string(argv[i + 1]), array, array_len))
+            {
+                return false;
+            }
+        }
+        if(arg_opt == "-q" || arg_opt == "--queries")
+        {
+            qfilename = string(argv[i + 1]);
+        }
+        if(arg_opt == "-o" || arg_opt == "--output")
+        {
+            ofilename = string(argv[i + 1]);
+        }
+        if(arg_opt == "-t" || arg_opt == "--threads")
+        {
+            n_threads = atoi(argv[i + 1]);
+        }
+    }
+    if(*array == nullptr)
+    {
+        if(!read_array_term(array, array_len))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Dtype *array = nullptr;
+    int array_len = 0;
+    string qfilename = "", ofilename = "";
+    int n_threads = thread::hardware_concurrency();
+
+    //Parse and get inputs
+    if(!parse_and_get_inputs(argc, argv, &array, array_len, qfilename,
+                ofilename, n_threads))
+    {
+        delete[] array;
+        return 0;
+    }
+
+    //Build the tree
+    SegmentTree tree;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool ok = segment_tree_build(tree, array, array_len, n_threads);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    delete[] array;
+    if(!ok)
+    {
+        return 0;
+    }
+    cout << "Time taken to build the tree: " << time.count() * 1000 <<
+        " ms.\n";
+
+    //Run the operations
+    ifstream qfp;
+    ofstream ofp;
+    if(!qfilename.empty())
+    {
+        qfp.open(qfilename);
+        if(!qfp.is_open())
+        {
+            cout << "Error: Operations file could not be opened\n";
+            segment_tree_free(tree);
+            return 0;
+        }
+    }
+    else
+    {
+        cout << "Enter operations (q l r or u i v, anything else to stop):"
+            << endl;
+    }
+    if(!ofilename.empty())
+    {
+        ofp.open(ofilename);
+        if(!ofp.is_open())
+        {
+            cout << "Could not open file for writing.\n";
+            segment_tree_free(tree);
+            return 0;
+        }
+    }
+    run_operations(tree, qfilename.empty() ? cin : qfp,
+            ofilename.empty() ? cout : ofp);
+
+    segment_tree_free(tree);
+    return 0;
+}
@@ -0,0 +1,402 @@
+/**
+  Find the maximum sum subrectangle of a matrix.
+
+  For a pair of rows top <= bottom, the sums of each column over the rows
+  top to bottom form an array, and the best rectangle between these rows is
+  the maximum subarray of it (Kadane's algorithm, as in
+  002_find_max_subarray_faster). The column sums for (top, bottom) are those
+  for (top, bottom - 1) plus row bottom, so all the pairs take
+  O(rows^2 cols). If there are more rows than columns, the matrix is
+  transposed first, so that the cost is O(min^2 max).
+
+  Kadane's algorithm is a chain over the columns, so it is vectorized over
+  row pairs instead: LANES consecutive tops are processed together with the
+  same bottom. Their column sums are interleaved (column j of top + k at
+  j * LANES + k), so that adding a row is one vector add per column and the
+  Kadane step is branchless, with maximums and blends. Each thread takes the
+  next block of tops from a shared counter.
+
+  Complexity: rows^2 cols
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <limits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+typedef float Dtype;
+
+//Number of tops processed together
+const int LANES = 8;
+
+
+/**
+  A rectangle: rows [top, bottom) and columns [left, right)
+  */
+struct Rectangle
+{
+    int top;
+    int bottom;
+    int left;
+    int right;
+    Dtype sum;
+};
+
+
+/**
+  Kadane's algorithm on the interleaved column sums cs of LANES tops, one
+  per lane. Lane k is skipped unless active[k]. The best rectangle of each
+  lane ending at row bottom replaces best if its sum is larger.
+  */
+void kadane_lanes(const Dtype *cs, int cols, int top0, int bottom,
+        const bool *active, Rectangle &best)
+{
+    Dtype lane_best[LANES];
+    int lane_left[LANES], lane_right[LANES];
+    int j = 0;
+#if defined(__AVX2__)
+    {
+        __m256 vcur = _mm256_setzero_ps();
+        __m256 vbest = _mm256_set1_ps(numeric_limits<Dtype>::lowest());
+        __m256i vstart = _mm256_setzero_si256();
+        __m256i vleft = vstart, vright = vstart;
+        __m256i vj = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi32(1);
+        for(; j < cols; ++j)
+        {
+            __m256 x = _mm256_loadu_ps(cs + j * LANES);
+            __m256 ext = _mm256_add_ps(vcur, x);
+            //Start a new run at j where x alone is better
+            __m256i restart = _mm256_castps_si256(_mm256_cmp_ps(x, ext,
+                        _CMP_GT_OQ));
+            vstart = _mm256_blendv_epi8(vstart, vj, restart);
+            vcur = _mm256_max_ps(ext, x);
+            vj = _mm256_add_epi32(vj, one);
+            __m256i better = _mm256_castps_si256(_mm256_cmp_ps(vcur, vbest,
+                        _CMP_GT_OQ));
+            vbest = _mm256_max_ps(vbest, vcur);
+            vleft = _mm256_blendv_epi8(vleft, vstart, better);
+            vright = _mm256_blendv_epi8(vright, vj, better);
+        }
+        _mm256_storeu_ps(lane_best, vbest);
+        _mm256_storeu_si256((__m256i *)lane_left, vleft);
+        _mm256_storeu_si256((__m256i *)lane_right, vright);
+    }
+#else
+    Dtype cur[LANES];
+    int start[LANES];
+    for(int k = 0; k < LANES; ++k)
+    {
+        cur[k] = 0;
+        start[k] = 0;
+        lane_best[k] = numeric_limits<Dtype>::lowest();
+        lane_left[k] = lane_right[k] = 0;
+    }
+    for(; j < cols; ++j)
+    {
+        for(int k = 0; k < LANES; ++k)
+        {
+            Dtype x = cs[j * LANES + k];
+            Dtype ext = cur[k] + x;
+            start[k] = (x > ext) ? j : start[k];
+            cur[k] = (x > ext) ? x : ext;
+            bool better = cur[k] > lane_best[k];
+            lane_best[k] = better ? cur[k] : lane_best[k];
+            lane_left[k] = better ? start[k] : lane_left[k];
+            lane_right[k] = better ? j + 1 : lane_right[k];
+        }
+    }
+#endif
+    for(int k = 0; k < LANES; ++k)
+    {
+        if(active[k] && lane_best[k] > best.sum)
+        {
+            best.sum = lane_best[k];
+            best.top = top0 + k;
+            best.bottom = bottom + 1;
+            best.left = lane_left[k];
+            best.right = lane_right[k];
+        }
+    }
+}
+
+
+/**
+  Best rectangle with its top in [top0, top0 + LANES), written to best if
+  larger. cs is scratch of cols * LANES values.
+  */
+void max_subrectangle_tops(const Dtype *array, int rows, int cols, int top0,
+        Dtype *cs, Rectangle &best)
+{
+    bool active[LANES];
+    for(int i = 0; i < cols * LANES; ++i) cs[i] = 0;
+    for(int bottom = top0; bottom < rows; ++bottom)
+    {
+        //Lanes whose top is at most bottom get the row
+        const Dtype *row = array + (size_t)bottom * cols;
+        int n_active = bottom - top0 + 1;
+        if(n_active > LANES) n_active = LANES;
+        if(top0 + n_active > rows) n_active = rows - top0;
+        for(int k = 0; k < LANES; ++k) active[k] = k < n_active;
+        if(n_active == LANES)
+        {
+            int j = 0;
+#if defined(__AVX2__)
+            for(; j < cols; ++j)
+            {
+                __m256 v = _mm256_loadu_ps(cs + j * LANES);
+                _mm256_storeu_ps(cs + j * LANES,
+                        _mm256_add_ps(v, _mm256_set1_ps(row[j])));
+            }
+#endif
+            for(; j < cols; ++j)
+            {
+                for(int k = 0; k < LANES; ++k) cs[j * LANES + k] += row[j];
+            }
+        }
+        else
+        {
+            for(int j = 0; j < cols; ++j)
+            {
+                for(int k = 0; k < n_active; ++k) cs[j * LANES + k] += row[j];
+            }
+        }
+        kadane_lanes(cs, cols, top0, bottom, active, best);
+    }
+}
+
+
+/**
+  Find the maximum sum subrectangle of array (rows X cols, row-wise) with
+  n_threads threads
+  */
+bool find_max_subrectangle(const Dtype *array, int rows, int cols,
+        int n_threads, Rectangle &result)
+{
+    if(rows <= 0 || cols <= 0)
+    {
+        cout << "Error: I cannot search an empty matrix.\n";
+        return false;
+    }
+
+    //Make rows the smaller dimension
+    const Dtype *a = array;
+    Dtype *transposed = nullptr;
+    bool swapped = rows > cols;
+    if(swapped)
+    {
+        transposed = new Dtype[(size_t)rows * cols];
+        for(int i = 0; i < rows; ++i)
+        {
+            for(int j = 0; j < cols; ++j)
+            {
+                transposed[(size_t)j * rows + i] = array[(size_t)i * cols + j];
+            }
+        }
+        a = transposed;
+        int t = rows;
+        rows = cols;
+        cols = t;
+    }
+
+    int n_blocks = (rows + LANES - 1) / LANES;
+    if(n_threads < 1) n_threads = 1;
+    if(n_threads > n_blocks) n_threads = n_blocks;
+    Rectangle *best = new Rectangle[n_threads];
+    thread *threads = new thread[n_threads];
+    atomic<int> next_block(0);
+    for(int t = 0; t < n_threads; ++t)
+    {
+        best[t].sum = numeric_limits<Dtype>::lowest();
+        best[t].top = best[t].bottom = best[t].left = best[t].right = 0;
+        threads[t] = thread([&, t]()
+        {
+            Dtype *cs = new Dtype[(size_t)cols * LANES];
+            for(int b = next_block++; b < n_blocks; b = next_block++)
+            {
+                max_subrectangle_tops(a, rows, cols, b * LANES, cs, best[t]);
+            }
+            delete[] cs;
+        });
+    }
+    for(int t = 0; t < n_threads; ++t)
+    {
+        threads[t].join();
+    }
+    result = best[0];
+    for(int t = 1; t < n_threads; ++t)
+    {
+        if(best[t].sum > result.sum) result = best[t];
+    }
+    if(swapped)
+    {
+        Rectangle r = result;
+        result.top = r.left;
+        result.bottom = r.right;
+        result.left = r.top;
+        result.right = r.bottom;
+    }
+    delete[] best;
+    delete[] threads;
+    delete[] transposed;
+    return true;
+}
+
+
+/**
+  Read matrix from terminal
+  */
+bool read_matrix_term(Dtype **array, int &row, int &col)
+{
+    cout << "Enter the size of the matrix (as row col): ";
+    cin >> row >> col;
+    if(row <= 0 || col <= 0) return true;
+    *array = new Dtype[row * col];
+    cout << "Enter the matrix elements row-wise: ";
+    for(int i = 0; i < row; ++i)
+    {
+        for(int j =0; j < col; ++j)
+        {
+            cin >> (*array)[i * col + j];
+        }
+    }
+   return true;
+}
+
+
+/**
+  Read array from file
+  */
+bool read_matrix_file(const string filename, Dtype **array, int &row, int &col)
+{
+    ifstream fp {filename};
+    cout << "Reading input file... ";
+    if(!fp.is_open())
+    {
+        cout << "Error: Input file could not be opened\n";
+        return false;
+    }
+    fp >> row >> col;
+    if(row <= 0 || col <= 0) return true;
+    *array = new Dtype[row * col];
+    for(int i = 0; i < row; ++i)
+    {
+        for(int j =0; j < col; ++j)
+        {
+            fp >> (*array)[i * col + j];
+        }
+    }
+    fp.close();
+    cout << "Read " << row << "X" << col << " matrix." << endl;
+    return true;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Find maximum sum subrectangle. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -i <input file> -t <number of threads>" <<
+        endl;
+    cout << "   Reads input matrix from input file. First two elements in the"\
+        " file must be size (i.e., row col) of the matrix. By default, all"\
+        " the cores are used.\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
+        int &rows, int &cols, int &n_threads)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    *array = nullptr;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input")
+        {
+            if(!read_matrix_file(string(argv[i + 1]), array, rows, cols))
+            {
+                return false;
+            }
+        }
+        if(arg_opt == "-t" || arg_opt == "--threads")
+        {
+            n_threads = atoi(argv[i + 1]);
+        }
+    }
+    if(*array == nullptr)
+    {
+        if(!read_matrix_term(array, rows, cols))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Dtype *array = nullptr;
+    int rows = 0, cols = 0;
+    int n_threads = thread::hardware_concurrency();
+
+    //Parse and get inputs
+    if(!parse_and_get_inputs(argc, argv, &array, rows, cols, n_threads))
+    {
+        return 0;
+    }
+
+    //Find max subrectangle
+    Rectangle r;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool ok = find_max_subrectangle(array, rows, cols, n_threads, r);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    if(ok)
+    {
+        cout << "Time taken to find the subrectangle: " << time.count() * 1000
+            << " ms.\n";
+        cout << fixed;
+        cout << "Maximum subrectangle sum is " << r.sum << endl;
+        cout << "Maximum subrectangle lies at rows [" << r.top + 1 << ", " <<
+            r.bottom << "] and columns [" << r.left + 1 << ", " << r.right <<
+            "].\n";
+    }
+
+    //Free memory if any
+    if(array != nullptr)
+    {
+        delete[] array;
+    }
+
+    return 0;
+}
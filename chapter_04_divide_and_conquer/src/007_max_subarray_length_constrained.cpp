@@ -0,0 +1,440 @@
+/**
+  Find the maximum subarray whose length is in [l_min, l_max].
+
+  With prefix sums P[0] = 0, P[j] = array[0] + ... + array[j - 1], the sum
+  of array[i .. j - 1] is P[j] - P[i]. For the subarrays ending at j with
+  length in [l_min, l_max], i is in [j - l_max, j - l_min], so the best one
+  subtracts the minimum of P over this window. The window slides by one
+  when j grows by one, and its minimum is kept by a monotonic deque:
+  - i = j - l_min enters at the back, after removing the indices whose
+    prefix sums are not smaller (they can never be the minimum again),
+  - indices older than j - l_max leave at the front,
+  so the front is the minimum and every index enters and leaves once.
+
+  The values are consumed one at a time, so the same code works on an array
+  or on a stream of unknown length. Only the last l_max + 1 prefix sums and
+  the deque (at most l_max - l_min + 1 indices) are kept, in ring buffers.
+  Prefix sums are kept in double, so that they do not lose the precision of
+  the values over long inputs.
+
+  Complexity: n (memory: l_max)
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <chrono>
+
+using namespace std;
+
+typedef float Dtype;
+
+//Number of values read at a time in streaming mode, and the default
+//number of values between reports
+const int STREAM_CHUNK = 4096;
+const int64_t DEFAULT_REPORT_EVERY = 1000000;
+
+
+/**
+  State of the search. count values have been seen. Prefix sum P[i] is at
+  prefix[i % cap] for the last cap = l_max + 1 of them. The deque holds the
+  indices deque[k % cap] for head <= k < tail. The best subarray so far is
+  [beg, end) with sum best, if found.
+  */
+struct ConstrainedState
+{
+    int64_t l_min;
+    int64_t l_max;
+    int64_t cap;
+    int64_t count;
+    double *prefix;
+    int64_t *deque;
+    int64_t head;
+    int64_t tail;
+    bool found;
+    double best;
+    int64_t beg;
+    int64_t end;
+};
+
+
+/**
+  Start a search for lengths in [l_min, l_max]
+  */
+bool constrained_init(ConstrainedState &st, int64_t l_min, int64_t l_max)
+{
+    st.prefix = nullptr;
+    st.deque = nullptr;
+    if(l_min < 1 || l_max < l_min)
+    {
+        cout << "Error: Lengths must satisfy 1 <= l_min <= l_max\n";
+        return false;
+    }
+    st.l_min = l_min;
+    st.l_max = l_max;
+    st.cap = l_max + 1;
+    st.count = 0;
+    st.prefix = new double[st.cap];
+    st.deque = new int64_t[st.cap];
+    st.prefix[0] = 0;
+    st.head = st.tail = 0;
+    st.found = false;
+    st.best = 0;
+    st.beg = st.end = 0;
+    return true;
+}
+
+
+/**
+  Free the buffers
+  */
+void constrained_free(ConstrainedState &st)
+{
+    delete[] st.prefix;
+    delete[] st.deque;
+    st.prefix = nullptr;
+    st.deque = nullptr;
+}
+
+
+/**
+  Continue with n more values
+  */
+void constrained_update(ConstrainedState &st, const Dtype *values, int n)
+{
+    const int64_t cap = st.cap;
+    for(int k = 0; k < n; ++k)
+    {
+        //New prefix sum P[j]
+        int64_t j = st.count + 1;
+        double pj = st.prefix[st.count % cap] + values[k];
+        st.prefix[j % cap] = pj;
+        st.count = j;
+
+        //i = j - l_min enters the window
+        int64_t i = j - st.l_min;
+        if(i >= 0)
+        {
+            double pi = st.prefix[i % cap];
+            while(st.tail > st.head &&
+                    st.prefix[st.deque[(st.tail - 1) % cap] % cap] >= pi)
+            {
+                --st.tail;
+            }
+            st.deque[st.tail % cap] = i;
+            ++st.tail;
+        }
+        //Indices before j - l_max leave it
+        while(st.tail > st.head && st.deque[st.head % cap] < j - st.l_max)
+        {
+            ++st.head;
+        }
+        if(st.tail > st.head)
+        {
+            int64_t front = st.deque[st.head % cap];
+            double sum = pj - st.prefix[front % cap];
+            if(!st.found || sum > st.best)
+            {
+                st.found = true;
+                st.best = sum;
+                st.beg = front;
+                st.end = j;
+            }
+        }
+    }
+}
+
+
+/**
+  Batch mode: maximum subarray of array with length in [l_min, l_max].
+  Returns false if there is no such subarray. l_max may exceed the length
+  of the array (to mean no upper limit).
+  */
+bool find_max_subarray_constrained(const Dtype *array, int64_t array_len,
+        int64_t l_min, int64_t l_max, int64_t &beg, int64_t &end, double &sum)
+{
+    //No subarray is longer than the array, so the buffers need not be
+    //longer either
+    if(l_min >= 1 && l_max >= l_min && l_min > array_len) return false;
+    if(l_max > array_len) l_max = array_len;
+    ConstrainedState st;
+    if(!constrained_init(st, l_min, l_max)) return false;
+    for(int64_t done = 0; done < array_len; done += STREAM_CHUNK)
+    {
+        int64_t n = array_len - done;
+        constrained_update(st, array + done, int(n < STREAM_CHUNK ? n :
+                    STREAM_CHUNK));
+    }
+    beg = st.beg;
+    end = st.end;
+    sum = st.best;
+    bool found = st.found;
+    constrained_free(st);
+    return found;
+}
+
+
+/**
+  Print the best subarray so far
+  */
+void print_constrained_state(const ConstrainedState &st)
+{
+    cout << "After " << st.count << " values: ";
+    if(st.found)
+    {
+        cout << "maximum subarray sum " << st.best << " at [" << st.beg + 1 <<
+            ", " << st.end << "]" << endl;
+    }
+    else
+    {
+        cout << "no subarray of the allowed lengths" << endl;
+    }
+}
+
+
+/**
+  Streaming mode: values are read from in until the end of the input, in
+  chunks of STREAM_CHUNK. Every report_every values (if positive) the best
+  subarray so far is printed.
+  */
+void find_max_subarray_constrained_stream(istream &in, int64_t report_every,
+        ConstrainedState &st)
+{
+    Dtype chunk[STREAM_CHUNK];
+    int64_t next_report = report_every;
+    while(in)
+    {
+        int n = 0;
+        while(n < STREAM_CHUNK && in >> chunk[n]) ++n;
+        constrained_update(st, chunk, n);
+        if(report_every > 0 && st.count >= next_report)
+        {
+            print_constrained_state(st);
+            while(next_report <= st.count) next_report += report_every;
+        }
+    }
+    if(!in.eof())
+    {
+        cout << "Warning: Stopped at a value that could not be read\n";
+    }
+}
+
+
+/**
+  Read array from terminal
+  */
+bool read_array_term(Dtype **array, int &array_len)
+{
+    cout << "Enter the length of the array: ";
+    cin >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    cout << "Enter the array elements: ";
+    for(int i = 0; i < array_len; ++i)
+    {
+        cin >> (*array)[i];
+    }
+   return true;
+}
+
+
+/**
+  Read array from file
+  */
+bool read_array_file(const string filename, Dtype **array, int &array_len)
+{
+    ifstream fp {filename};
+    cout << "Reading input file... ";
+    if(!fp.is_open())
+    {
+        cout << "Error: Input file could not be opened\n";
+        return false;
+    }
+    fp >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    for(int i = 0; i < array_len; ++i)
+    {
+        fp >> (*array)[i];
+    }
+    fp.close();
+    cout << "Read " << array_len << " elements." << endl;
+    return true;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Find maximum subarray with length in [l_min, l_max]. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -i <input file> -l <l_min> -u <l_max>" <<
+        endl;
+    cout << "   Reads input array from input file. First element in the file"\
+        " must be the length of the array.\n\n";
+    cout << "3. " << command << " -s <input file | -> -l <l_min> -u <l_max>"\
+        " -r <report interval>" << endl;
+    cout << "   Streaming mode. Reads values (without the length) from the"\
+        " file, or from the standard input for -, until the end of the input."\
+        " The best subarray so far is printed every report interval values"\
+        " (default " << DEFAULT_REPORT_EVERY << ", 0 for none).\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
+        int &array_len, int64_t &l_min, int64_t &l_max, string &stream_name,
+        int64_t &report_every)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    *array = nullptr;
+    string ifilename = "";
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input")
+        {
+            ifilename = string(argv[i + 1]);
+        }
+        if(arg_opt == "-l" || arg_opt == "--min")
+        {
+            l_min = atoll(argv[i + 1]);
+        }
+        if(arg_opt == "-u" || arg_opt == "--max")
+        {
+            l_max = atoll(argv[i + 1]);
+        }
+        if(arg_opt == "-s" || arg_opt == "--stream")
+        {
+            stream_name = string(argv[i + 1]);
+        }
+        if(arg_opt == "-r" || arg_opt == "--report")
+        {
+            report_every = atoll(argv[i + 1]);
+        }
+    }
+    //Streaming mode reads the input later
+    if(!stream_name.empty())
+    {
+        return true;
+    }
+    if(!ifilename.empty())
+    {
+        if(!read_array_file(ifilename, array, array_len))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if(!read_array_term(array, array_len))
+        {
+            return false;
+        }
+        cout << "Enter the minimum and maximum lengths: ";
+        cin >> l_min >> l_max;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Dtype *array = nullptr;
+    int array_len = 0;
+    int64_t l_min = 1, l_max = 1;
+    string stream_name = "";
+    int64_t report_every = DEFAULT_REPORT_EVERY;
+
+    //Parse and get inputs
+    if(!parse_and_get_inputs(argc, argv, &array, array_len, l_min, l_max,
+                stream_name, report_every))
+    {
+        return 0;
+    }
+
+    //Streaming mode
+    if(!stream_name.empty())
+    {
+        ConstrainedState st;
+        if(!constrained_init(st, l_min, l_max))
+        {
+            return 0;
+        }
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        if(stream_name == "-")
+        {
+            //cin is buffered by itself only without the C stdio sync
+            ios_base::sync_with_stdio(false);
+            find_max_subarray_constrained_stream(cin, report_every, st);
+        }
+        else
+        {
+            ifstream fp {stream_name};
+            if(!fp.is_open())
+            {
+                cout << "Error: Input file could not be opened\n";
+                constrained_free(st);
+                return 0;
+            }
+            find_max_subarray_constrained_stream(fp, report_every, st);
+        }
+        chrono::duration<double> time = chrono::steady_clock::now() - t0;
+        cout << fixed;
+        print_constrained_state(st);
+        cout << "Time taken: " << time.count() * 1000 << " ms.\n";
+        constrained_free(st);
+        return 0;
+    }
+
+    //Find max subarray
+    int64_t beg, end;
+    double sum;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool found = find_max_subarray_constrained(array, array_len, l_min, l_max,
+            beg, end, sum);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << "Time taken to find the subarray: " << time.count() * 1000 <<
+        " ms.\n";
+
+    //Print result
+    if(found)
+    {
+        cout << fixed;
+        cout << "Maximum subarray sum is " << sum << endl;
+        cout << "Maximum subarray lies at [" << beg + 1 << ", " << end << "].\n";
+    }
+    else
+    {
+        cout << "No subarray has a length in [" << l_min << ", " << l_max <<
+            "]." << endl;
+    }
+
+    //Free memory if any
+    if(array != nullptr)
+    {
+        delete[] array;
+    }
+
+    return 0;
+}
@@ -0,0 +1,481 @@
+/**
+  Find the k best disjoint maximum subarrays.
+
+  The subarrays are taken greedily: the first is the maximum subarray of the
+  array, and each next one is the maximum subarray of what is left after
+  removing the ones taken before. Removing [beg, end) from a segment
+  [lo, hi) leaves the segments [lo, beg) and [end, hi), so the candidates
+  are the maximum subarrays of a set of disjoint segments:
+  - a max heap keeps the segments keyed by the sum of their maximum
+    subarray,
+  - the top of the heap is the next subarray, and its segment is replaced
+    by the two pieces around it.
+  Being greedy, it can use up the array before k subarrays although k
+  disjoint ones exist: in [5, -1, 5] the first subarray is the whole array.
+  Once no positive sum is left, the next subarrays are fragments with sums
+  <= 0, unless only positive sums are asked for (as for anomaly windows).
+
+  The maximum subarray of a segment is a range query on a segment tree of
+  summaries (total, best prefix, best suffix and best subarray), as in
+  005_max_subarray_segment_tree, so each step costs O(log n). The tree is
+  stored bottom-up in 2 n nodes, which works for any n since the pieces of
+  a query are combined in order. Indices are 64 bit.
+
+  Complexity: n + k log n
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <chrono>
+
+using namespace std;
+
+typedef float Dtype;
+
+//Number of subarrays found by default
+const int64_t DEFAULT_K = 10;
+
+
+/**
+  Summary of a piece of the array. Ranges are [beg, end) in indices of the
+  array. An empty piece has len 0.
+  */
+struct SubarraySummary
+{
+    int64_t len;
+    Dtype total;
+    Dtype prefix;
+    int64_t prefix_end;
+    Dtype suffix;
+    int64_t suffix_beg;
+    Dtype best;
+    int64_t best_beg;
+    int64_t best_end;
+};
+
+
+/**
+  A subarray [beg, end) with its sum
+  */
+struct Subarray
+{
+    int64_t beg;
+    int64_t end;
+    Dtype sum;
+};
+
+
+/**
+  A segment [lo, hi) of the array with its maximum subarray
+  */
+struct Candidate
+{
+    int64_t lo;
+    int64_t hi;
+    Subarray best;
+};
+
+
+/**
+  Summary of the single value at index i
+  */
+inline SubarraySummary leaf_summary(Dtype value, int64_t i)
+{
+    SubarraySummary s;
+    s.len = 1;
+    s.total = s.prefix = s.suffix = s.best = value;
+    s.prefix_end = s.best_end = i + 1;
+    s.suffix_beg = s.best_beg = i;
+    return s;
+}
+
+
+/**
+  Summary of the concatenation of the pieces summarized by l and r
+  */
+inline SubarraySummary combine_summaries(const SubarraySummary &l,
+        const SubarraySummary &r)
+{
+    if(l.len == 0) return r;
+    if(r.len == 0) return l;
+    SubarraySummary s;
+    s.len = l.len + r.len;
+    s.total = l.total + r.total;
+    s.prefix = l.prefix;
+    s.prefix_end = l.prefix_end;
+    if(l.total + r.prefix > s.prefix)
+    {
+        s.prefix = l.total + r.prefix;
+        s.prefix_end = r.prefix_end;
+    }
+    s.suffix = r.suffix;
+    s.suffix_beg = r.suffix_beg;
+    if(l.suffix + r.total > s.suffix)
+    {
+        s.suffix = l.suffix + r.total;
+        s.suffix_beg = l.suffix_beg;
+    }
+    s.best = l.best;
+    s.best_beg = l.best_beg;
+    s.best_end = l.best_end;
+    if(l.suffix + r.prefix > s.best)
+    {
+        s.best = l.suffix + r.prefix;
+        s.best_beg = l.suffix_beg;
+        s.best_end = r.prefix_end;
+    }
+    if(r.best > s.best)
+    {
+        s.best = r.best;
+        s.best_beg = r.best_beg;
+        s.best_end = r.best_end;
+    }
+    return s;
+}
+
+
+/**
+  Build the tree nodes[1 .. 2 n - 1] over array. The leaves are
+  nodes[n .. 2 n - 1].
+  */
+SubarraySummary *build_tree(const Dtype *array, int64_t n)
+{
+    SubarraySummary *nodes = new SubarraySummary[2 * n];
+    for(int64_t i = 0; i < n; ++i)
+    {
+        nodes[n + i] = leaf_summary(array[i], i);
+    }
+    for(int64_t i = n - 1; i >= 1; --i)
+    {
+        nodes[i] = combine_summaries(nodes[2 * i], nodes[2 * i + 1]);
+    }
+    return nodes;
+}
+
+
+/**
+  Maximum subarray of array[l .. r - 1] (0 <= l < r <= n)
+  */
+Subarray query_tree(const SubarraySummary *nodes, int64_t n, int64_t l,
+        int64_t r)
+{
+    SubarraySummary left, right;
+    left.len = right.len = 0;
+    for(l += n, r += n; l < r; l /= 2, r /= 2)
+    {
+        if(l & 1) left = combine_summaries(left, nodes[l++]);
+        if(r & 1) right = combine_summaries(nodes[--r], right);
+    }
+    SubarraySummary s = combine_summaries(left, right);
+    Subarray result;
+    result.beg = s.best_beg;
+    result.end = s.best_end;
+    result.sum = s.best;
+    return result;
+}
+
+
+/**
+  Insert c into the max heap heap[0 .. heap_len - 1]
+  */
+void heap_push(Candidate *heap, int64_t &heap_len, const Candidate &c)
+{
+    int64_t i = heap_len++;
+    while(i > 0)
+    {
+        int64_t parent = (i - 1) / 2;
+        if(heap[parent].best.sum >= c.best.sum) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = c;
+}
+
+
+/**
+  Remove and return the top of the max heap (heap_len > 0)
+  */
+Candidate heap_pop(Candidate *heap, int64_t &heap_len)
+{
+    Candidate top = heap[0];
+    Candidate last = heap[--heap_len];
+    int64_t i = 0;
+    while(true)
+    {
+        int64_t child = 2 * i + 1;
+        if(child >= heap_len) break;
+        if(child + 1 < heap_len &&
+                heap[child + 1].best.sum > heap[child].best.sum)
+        {
+            ++child;
+        }
+        if(last.best.sum >= heap[child].best.sum) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+    return top;
+}
+
+
+/**
+  Push the segment [lo, hi) with its maximum subarray, if it is not empty
+  */
+void push_segment(const SubarraySummary *nodes, int64_t n, Candidate *heap,
+        int64_t &heap_len, int64_t lo, int64_t hi)
+{
+    if(lo >= hi) return;
+    Candidate c;
+    c.lo = lo;
+    c.hi = hi;
+    c.best = query_tree(nodes, n, lo, hi);
+    heap_push(heap, heap_len, c);
+}
+
+
+/**
+  Find up to k disjoint maximum subarrays of array, in decreasing order of
+  sum. They are written to result (of length k), and their number is
+  returned. It is less than k only if the array is used up, or, with
+  positive_only, if no subarray with a positive sum is left. Without
+  positive_only, the last ones may have sums <= 0 (single values and
+  fragments left between the earlier subarrays).
+  */
+int64_t find_top_k_subarrays(const Dtype *array, int64_t array_len,
+        int64_t k, bool positive_only, Subarray *result)
+{
+    if(array_len <= 0 || k <= 0) return 0;
+    SubarraySummary *nodes = build_tree(array, array_len);
+    //Each step replaces one segment by at most two
+    Candidate *heap = new Candidate[k + 1];
+    int64_t heap_len = 0;
+    push_segment(nodes, array_len, heap, heap_len, 0, array_len);
+    int64_t count = 0;
+    while(count < k && heap_len > 0)
+    {
+        //The top is the largest sum left
+        if(positive_only && heap[0].best.sum <= 0) break;
+        Candidate c = heap_pop(heap, heap_len);
+        result[count++] = c.best;
+        if(count == k) break;
+        push_segment(nodes, array_len, heap, heap_len, c.lo, c.best.beg);
+        push_segment(nodes, array_len, heap, heap_len, c.best.end, c.hi);
+    }
+    delete[] heap;
+    delete[] nodes;
+    return count;
+}
+
+
+/**
+  Read array from terminal
+  */
+bool read_array_term(Dtype **array, int64_t &array_len)
+{
+    cout << "Enter the length of the array: ";
+    cin >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    cout << "Enter the array elements: ";
+    for(int64_t i = 0; i < array_len; ++i)
+    {
+        cin >> (*array)[i];
+    }
+   return true;
+}
+
+
+/**
+  Read array from file
+  */
+bool read_array_file(const string filename, Dtype **array, int64_t &array_len)
+{
+    ifstream fp {filename};
+    cout << "Reading input file... ";
+    if(!fp.is_open())
+    {
+        cout << "Error: Input file could not be opened\n";
+        return false;
+    }
+    fp >> array_len;
+    if(array_len <= 0) return true;
+    *array = new Dtype[array_len];
+    for(int64_t i = 0; i < array_len; ++i)
+    {
+        fp >> (*array)[i];
+    }
+    fp.close();
+    cout << "Read " << array_len << " elements." << endl;
+    return true;
+}
+
+
+/**
+  Write the subarrays as lines of "beg end sum" (1 based, inclusive)
+  */
+bool write_subarrays_file(const string filename, const Subarray *subarrays,
+        int64_t count)
+{
+    ofstream ofp{filename};
+    if(!ofp.is_open())
+    {
+        cout << "Could not open file for writing.\n";
+        return false;
+    }
+    ofp << fixed;
+    for(int64_t i = 0; i < count; ++i)
+    {
+        ofp << subarrays[i].beg + 1 << " " << subarrays[i].end << " " <<
+            subarrays[i].sum << endl;
+    }
+    ofp.close();
+    cout << "Written " << count << " subarrays in " << filename << endl;
+    return true;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Find the k best disjoint maximum subarrays. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -i <input file> -k <number of subarrays>"\
+        " -p <1|0> -o <output file>" << endl;
+    cout << "   Reads input array from input file. First element in the file"\
+        " must be the length of the array. k is " << DEFAULT_K << " by"\
+        " default. With -p 1, only subarrays with positive sums are"\
+        " reported. The subarrays are printed, or written as lines of"\
+        " \"begin end sum\" to the output file if given.\n";
+}
+
+
+/**
+  Parse and get all inputs
+  */
+bool parse_and_get_inputs(const int argc, char **argv, Dtype **array,
+        int64_t &array_len, int64_t &k, bool &positive_only,
+        string &ofilename)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return false;
+    }
+    *array = nullptr;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return false;
+        }
+        if(arg_opt == "-i" || arg_opt == "--input")
+        {
+            if(!read_array_file(string(argv[i + 1]), array, array_len))
+            {
+                return false;
+            }
+        }
+        if(arg_opt == "-k" || arg_opt == "--count")
+        {
+            k = atoll(argv[i + 1]);
+        }
+        if(arg_opt == "-p" || arg_opt == "--positive")
+        {
+            positive_only = atoi(argv[i + 1]) != 0;
+        }
+        if(arg_opt == "-o" || arg_opt == "--output")
+        {
+            ofilename = string(argv[i + 1]);
+        }
+    }
+    if(*array == nullptr)
+    {
+        if(!read_array_term(array, array_len))
+        {
+            return false;
+        }
+        cout << "Enter the number of subarrays: ";
+        cin >> k;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Dtype *array = nullptr;
+    int64_t array_len = 0;
+    int64_t k = DEFAULT_K;
+    bool positive_only = false;
+    string ofilename = "";
+
+    //Parse and get inputs
+    if(!parse_and_get_inputs(argc, argv, &array, array_len, k, positive_only,
+                ofilename))
+    {
+        return 0;
+    }
+    if(k <= 0)
+    {
+        cout << "Error: The number of subarrays must be positive\n";
+        delete[] array;
+        return 0;
+    }
+
+    //Find the subarrays
+    Subarray *subarrays = new Subarray[k];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    int64_t count = find_top_k_subarrays(array, array_len, k, positive_only,
+            subarrays);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << "Time taken to find the subarrays: " << time.count() * 1000 <<
+        " ms.\n";
+
+    //Print or write result
+    if(!ofilename.empty())
+    {
+        write_subarrays_file(ofilename, subarrays, count);
+    }
+    else
+    {
+        cout << fixed;
+        for(int64_t i = 0; i < count; ++i)
+        {
+            cout << i + 1 << ". Sum " << subarrays[i].sum << " at [" <<
+                subarrays[i].beg + 1 << ", " << subarrays[i].end << "]\n";
+        }
+    }
+    if(count < k)
+    {
+        cout << "Only " << count << " subarrays found: ";
+        if(positive_only)
+        {
+            cout << "no positive sum is left." << endl;
+        }
+        else
+        {
+            cout << "the greedy search used up the array." << endl;
+        }
+    }
+
+    //Free memory
+    delete[] subarrays;
+    if(array != nullptr)
+    {
+        delete[] array;
+    }
+
+    return 0;
+}
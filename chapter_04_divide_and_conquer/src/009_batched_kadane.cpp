@@ -0,0 +1,718 @@
+/**
+  Batch maximum subarray of many short independent series by Kadane's
+  algorithm, one series per SIMD lane.
+
+  Kadane's algorithm on one series (find_max_subarray_faster) is a chain of
+  dependent steps with two data dependent branches, which are mispredicted
+  often on random data. Here the series are stored as a structure of
+  arrays: they are split into blocks of LANES series, and inside a block the
+  values are transposed by time, so that row t holds the t-th value of all
+  the series of the block. The step of Kadane's algorithm is then done for
+  all the lanes at once, without branches:
+  - restart = (cur < 0), start = restart ? t : start
+  - cur = max(cur, 0) + x
+  - better = (cur > best) and (t < len), and where better:
+    best = cur, beg = start, end = t + 1
+  which is the same step as find_max_subarray_faster, so the results are the
+  same. With AVX-512 a block is one register of 16 floats, with AVX2 two
+  registers of 8. Two blocks are processed together, so that several
+  independent chains hide the latency of each other.
+
+  Series of different lengths are padded with zeros up to the longest
+  series of their block, and the lanes beyond the length of their series
+  are masked out. Each block is stored with its own length, so sorting the
+  series by length keeps both the padding and the work small.
+
+  Batch file format (binary, native byte order):
+  int32 n_series, int32 lens[n_series], then the values of each series as
+  float.
+
+  Compile with -O2 -march=native to enable AVX2 or AVX-512.
+
+  Complexity: sum over the blocks of LANES X (longest series of the block)
+
+Author: Sandeep Palakkal
+Email: sandeep.dion@gmail.com
+Created on: 19-Oct-2026
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+typedef float Dtype;
+
+//Number of series in a block of the structure of arrays
+const int LANES = 16;
+
+//Lengths of the series generated with -g
+const int GEN_MIN_LEN = 16;
+const int GEN_MAX_LEN = 256;
+
+
+/**
+  Series in structure of arrays layout. Block b has LANES series. The
+  longest series of block b has block_len[b] values, and value t of its
+  series in lane k is at values[block_off[b] + t * LANES + k]. The series
+  has lens[b * LANES + k] values. Missing series of the last block have
+  length 0.
+  */
+struct SeriesBatch
+{
+    int n_series;
+    int n_blocks;
+    int max_len;
+    Dtype *values;
+    int *lens;
+    int *block_len;
+    size_t *block_off;
+};
+
+
+/**
+  Free the batch
+  */
+void series_batch_free(SeriesBatch &batch)
+{
+    delete[] batch.values;
+    delete[] batch.lens;
+    delete[] batch.block_len;
+    delete[] batch.block_off;
+    batch.values = nullptr;
+    batch.lens = nullptr;
+    batch.block_len = nullptr;
+    batch.block_off = nullptr;
+    batch.n_series = batch.n_blocks = batch.max_len = 0;
+}
+
+
+/**
+  Build the batch from n_series series. series[s] has lens[s] values.
+  */
+bool series_batch_build(const Dtype * const *series, const int *lens,
+        int n_series, SeriesBatch &batch)
+{
+    batch.n_series = n_series;
+    batch.n_blocks = (n_series + LANES - 1) / LANES;
+    batch.max_len = 0;
+    batch.values = nullptr;
+    batch.lens = nullptr;
+    batch.block_len = nullptr;
+    batch.block_off = nullptr;
+    for(int s = 0; s < n_series; ++s)
+    {
+        if(lens[s] < 0)
+        {
+            cout << "Error: Series " << s << " has negative length\n";
+            return false;
+        }
+        if(lens[s] > batch.max_len) batch.max_len = lens[s];
+    }
+    batch.lens = new int[(size_t)batch.n_blocks * LANES + 1]{};
+    batch.block_len = new int[batch.n_blocks + 1]{};
+    batch.block_off = new size_t[batch.n_blocks + 1];
+    for(int s = 0; s < n_series; ++s)
+    {
+        int b = s / LANES;
+        batch.lens[s] = lens[s];
+        if(lens[s] > batch.block_len[b]) batch.block_len[b] = lens[s];
+    }
+    //Each block takes its own length only
+    size_t total = 0;
+    for(int b = 0; b < batch.n_blocks; ++b)
+    {
+        batch.block_off[b] = total;
+        total += (size_t)batch.block_len[b] * LANES;
+    }
+    batch.block_off[batch.n_blocks] = total;
+    batch.values = new Dtype[total + 1]{};
+    for(int s = 0; s < n_series; ++s)
+    {
+        int b = s / LANES, lane = s % LANES;
+        Dtype *block = batch.values + batch.block_off[b];
+        for(int t = 0; t < lens[s]; ++t)
+        {
+            block[t * LANES + lane] = series[s][t];
+        }
+    }
+    return true;
+}
+
+
+/**
+  Kadane's algorithm on the block at values (len rows) with the series
+  lengths lens, one lane at a time but without branches. Results of lane k
+  are written to beg[k], end[k] and sum[k].
+  */
+void kadane_block(const Dtype *values, int len, const int *lens, int *beg,
+        int *end, Dtype *sum)
+{
+    Dtype cur[LANES], best[LANES];
+    int start[LANES], left[LANES], right[LANES];
+    for(int k = 0; k < LANES; ++k)
+    {
+        cur[k] = best[k] = 0;
+        start[k] = left[k] = right[k] = 0;
+    }
+    for(int t = 0; t < len; ++t)
+    {
+        for(int k = 0; k < LANES; ++k)
+        {
+            Dtype x = values[t * LANES + k];
+            start[k] = (cur[k] < 0) ? t : start[k];
+            cur[k] = ((cur[k] < 0) ? 0 : cur[k]) + x;
+            bool better = (t == 0 || cur[k] > best[k]) && t < lens[k];
+            best[k] = better ? cur[k] : best[k];
+            left[k] = better ? start[k] : left[k];
+            right[k] = better ? t + 1 : right[k];
+        }
+    }
+    for(int k = 0; k < LANES; ++k)
+    {
+        beg[k] = left[k];
+        end[k] = right[k];
+        sum[k] = best[k];
+    }
+}
+
+
+#if defined(__AVX512F__)
+/**
+  State of Kadane's algorithm in 16 lanes
+  */
+struct KadaneLanes
+{
+    __m512 cur;
+    __m512 best;
+    __m512i start;
+    __m512i left;
+    __m512i right;
+    __m512i len;
+};
+
+
+inline void kadane_lanes_init(KadaneLanes &st, const int *lens)
+{
+    st.cur = _mm512_setzero_ps();
+    st.best = _mm512_setzero_ps();
+    st.start = st.left = st.right = _mm512_setzero_si512();
+    st.len = _mm512_loadu_si512(lens);
+}
+
+
+/**
+  Step t of Kadane's algorithm with the values x. The first step always
+  takes the value as the best.
+  */
+inline void kadane_lanes_step(KadaneLanes &st, __m512 x, __m512i vt,
+        __m512i vt1, bool first)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    __mmask16 restart = _mm512_cmp_ps_mask(st.cur, zero, _CMP_LT_OQ);
+    st.start = _mm512_mask_blend_epi32(restart, st.start, vt);
+    st.cur = _mm512_add_ps(_mm512_mask_blend_ps(restart, st.cur, zero), x);
+    __mmask16 better = first ? (__mmask16)0xFFFF :
+        _mm512_cmp_ps_mask(st.cur, st.best, _CMP_GT_OQ);
+    better &= _mm512_cmpgt_epi32_mask(st.len, vt);
+    st.best = _mm512_mask_blend_ps(better, st.best, st.cur);
+    st.left = _mm512_mask_blend_epi32(better, st.left, st.start);
+    st.right = _mm512_mask_blend_epi32(better, st.right, vt1);
+}
+
+
+inline void kadane_lanes_store(const KadaneLanes &st, int *beg, int *end,
+        Dtype *sum)
+{
+    _mm512_storeu_si512(beg, st.left);
+    _mm512_storeu_si512(end, st.right);
+    _mm512_storeu_ps(sum, st.best);
+}
+#elif defined(__AVX2__)
+/**
+  State of Kadane's algorithm in 8 lanes
+  */
+struct KadaneLanes
+{
+    __m256 cur;
+    __m256 best;
+    __m256i start;
+    __m256i left;
+    __m256i right;
+    __m256i len;
+};
+
+
+inline void kadane_lanes_init(KadaneLanes &st, const int *lens)
+{
+    st.cur = _mm256_setzero_ps();
+    st.best = _mm256_setzero_ps();
+    st.start = st.left = st.right = _mm256_setzero_si256();
+    st.len = _mm256_loadu_si256((const __m256i *)lens);
+}
+
+
+/**
+  Step t of Kadane's algorithm with the values x. The first step always
+  takes the value as the best.
+  */
+inline void kadane_lanes_step(KadaneLanes &st, __m256 x, __m256i vt,
+        __m256i vt1, bool first)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    __m256i restart = _mm256_castps_si256(_mm256_cmp_ps(st.cur, zero,
+                _CMP_LT_OQ));
+    st.start = _mm256_blendv_epi8(st.start, vt, restart);
+    st.cur = _mm256_add_ps(_mm256_max_ps(st.cur, zero), x);
+    __m256i better = first ? _mm256_set1_epi32(-1) :
+        _mm256_castps_si256(_mm256_cmp_ps(st.cur, st.best, _CMP_GT_OQ));
+    better = _mm256_and_si256(better, _mm256_cmpgt_epi32(st.len, vt));
+    st.best = _mm256_blendv_ps(st.best, st.cur, _mm256_castsi256_ps(better));
+    st.left = _mm256_blendv_epi8(st.left, st.start, better);
+    st.right = _mm256_blendv_epi8(st.right, vt1, better);
+}
+
+
+inline void kadane_lanes_store(const KadaneLanes &st, int *beg, int *end,
+        Dtype *sum)
+{
+    _mm256_storeu_si256((__m256i *)beg, st.left);
+    _mm256_storeu_si256((__m256i *)end, st.right);
+    _mm256_storeu_ps(sum, st.best);
+}
+#endif
+
+
+/**
+  Maximum subarray of each series of the batch. The subarray of series s is
+  [beg[s], end[s]) with sum sum[s]. Empty series get beg = end = 0 and
+  sum = 0.
+  */
+void series_batch_kadane(const SeriesBatch &batch, int *beg, int *end,
+        Dtype *sum)
+{
+    int b = 0;
+#if defined(__AVX512F__) || defined(__AVX2__)
+    const int full_blocks = batch.n_series / LANES;
+#endif
+#if defined(__AVX512F__)
+    //2 blocks of one register each
+    for(; b + 2 <= full_blocks; b += 2)
+    {
+        const Dtype *b0 = batch.values + batch.block_off[b];
+        const Dtype *b1 = batch.values + batch.block_off[b + 1];
+        const int *lens = batch.lens + b * LANES;
+        int n0 = batch.block_len[b], n1 = batch.block_len[b + 1];
+        int n = min(n0, n1);
+        KadaneLanes s0, s1;
+        kadane_lanes_init(s0, lens);
+        kadane_lanes_init(s1, lens + 16);
+        for(int t = 0; t < n; ++t)
+        {
+            __m512i vt = _mm512_set1_epi32(t), vt1 = _mm512_set1_epi32(t + 1);
+            kadane_lanes_step(s0, _mm512_loadu_ps(b0 + t * LANES), vt, vt1,
+                    t == 0);
+            kadane_lanes_step(s1, _mm512_loadu_ps(b1 + t * LANES), vt, vt1,
+                    t == 0);
+        }
+        //Rest of the longer block alone
+        for(int t = n; t < n0; ++t)
+        {
+            __m512i vt = _mm512_set1_epi32(t), vt1 = _mm512_set1_epi32(t + 1);
+            kadane_lanes_step(s0, _mm512_loadu_ps(b0 + t * LANES), vt, vt1,
+                    t == 0);
+        }
+        for(int t = n; t < n1; ++t)
+        {
+            __m512i vt = _mm512_set1_epi32(t), vt1 = _mm512_set1_epi32(t + 1);
+            kadane_lanes_step(s1, _mm512_loadu_ps(b1 + t * LANES), vt, vt1,
+                    t == 0);
+        }
+        int i = b * LANES;
+        kadane_lanes_store(s0, beg + i, end + i, sum + i);
+        kadane_lanes_store(s1, beg + i + 16, end + i + 16, sum + i + 16);
+    }
+#elif defined(__AVX2__)
+    //2 blocks of two registers each
+    for(; b + 2 <= full_blocks; b += 2)
+    {
+        const Dtype *b0 = batch.values + batch.block_off[b];
+        const Dtype *b1 = batch.values + batch.block_off[b + 1];
+        const int *lens = batch.lens + b * LANES;
+        int n0 = batch.block_len[b], n1 = batch.block_len[b + 1];
+        int n = min(n0, n1);
+        KadaneLanes s0, s1, s2, s3;
+        kadane_lanes_init(s0, lens);
+        kadane_lanes_init(s1, lens + 8);
+        kadane_lanes_init(s2, lens + 16);
+        kadane_lanes_init(s3, lens + 24);
+        for(int t = 0; t < n; ++t)
+        {
+            __m256i vt = _mm256_set1_epi32(t), vt1 = _mm256_set1_epi32(t + 1);
+            bool first = t == 0;
+            kadane_lanes_step(s0, _mm256_loadu_ps(b0 + t * LANES), vt, vt1,
+                    first);
+            kadane_lanes_step(s1, _mm256_loadu_ps(b0 + t * LANES + 8), vt,
+                    vt1, first);
+            kadane_lanes_step(s2, _mm256_loadu_ps(b1 + t * LANES), vt, vt1,
+                    first);
+            kadane_lanes_step(s3, _mm256_loadu_ps(b1 + t * LANES + 8), vt,
+                    vt1, first);
+        }
+        //Rest of the longer block alone
+        for(int t = n; t < n0; ++t)
+        {
+            __m256i vt = _mm256_set1_epi32(t), vt1 = _mm256_set1_epi32(t + 1);
+            kadane_lanes_step(s0, _mm256_loadu_ps(b0 + t * LANES), vt, vt1,
+                    t == 0);
+            kadane_lanes_step(s1, _mm256_loadu_ps(b0 + t * LANES + 8), vt,
+                    vt1, t == 0);
+        }
+        for(int t = n; t < n1; ++t)
+        {
+            __m256i vt = _mm256_set1_epi32(t), vt1 = _mm256_set1_epi32(t + 1);
+            kadane_lanes_step(s2, _mm256_loadu_ps(b1 + t * LANES), vt, vt1,
+                    t == 0);
+            kadane_lanes_step(s3, _mm256_loadu_ps(b1 + t * LANES + 8), vt,
+                    vt1, t == 0);
+        }
+        int i = b * LANES;
+        kadane_lanes_store(s0, beg + i, end + i, sum + i);
+        kadane_lanes_store(s1, beg + i + 8, end + i + 8, sum + i + 8);
+        kadane_lanes_store(s2, beg + i + 16, end + i + 16, sum + i + 16);
+        kadane_lanes_store(s3, beg + i + 24, end + i + 24, sum + i + 24);
+    }
+#endif
+    //Remaining blocks, through buffers of LANES results
+    for(; b < batch.n_blocks; ++b)
+    {
+        int bb[LANES], be[LANES];
+        Dtype bs[LANES];
+        kadane_block(batch.values + batch.block_off[b], batch.block_len[b],
+                batch.lens + b * LANES, bb, be, bs);
+        for(int k = 0; k < LANES && b * LANES + k < batch.n_series; ++k)
+        {
+            beg[b * LANES + k] = bb[k];
+            end[b * LANES + k] = be[k];
+            sum[b * LANES + k] = bs[k];
+        }
+    }
+}
+
+
+/**
+  Find the maximum subarray faster algorithm.
+  */
+void find_max_subarray_faster(const Dtype *array, int array_len,
+        int &beg, int &end, Dtype &sum)
+{
+    //If the array length is zero, return
+    if(array_len == 0)
+    {
+        beg = end = 0;
+        sum = 0;
+        return;
+    }
+
+    //Start from the first element
+    sum = array[0];
+    beg = 0;
+    end = 1;
+
+    Dtype sum_so_far = sum;
+    int left = beg;
+    if(sum_so_far < 0)
+    {
+        sum_so_far = 0;
+        left = 1;
+    }
+    for(int i = 1; i < array_len; ++i)
+    {
+        Dtype sum_here = sum_so_far + array[i];
+        if(sum_here > sum)
+        {
+            sum = sum_here;
+            beg = left;
+            end = i + 1;
+        }
+        if(sum_here < 0)
+        {
+            sum_so_far = 0;
+            left = i + 1;
+        }
+        else sum_so_far = sum_here;
+    }
+}
+
+
+/**
+  Read a batch file
+  */
+bool read_batch_file(const string filename, SeriesBatch &batch)
+{
+    ifstream fp(filename, ios::binary);
+    if(!fp.is_open())
+    {
+        cout << "Error: Could not open " << filename << endl;
+        return false;
+    }
+    int32_t n_series = 0;
+    fp.read((char *)&n_series, sizeof(n_series));
+    if(!fp || n_series < 0)
+    {
+        cout << "Error: Invalid batch file\n";
+        return false;
+    }
+    int *lens = new int[n_series > 0 ? n_series : 1];
+    Dtype **series = new Dtype*[n_series > 0 ? n_series : 1]{};
+    bool ok = true;
+    for(int s = 0; s < n_series && ok; ++s)
+    {
+        int32_t len;
+        fp.read((char *)&len, sizeof(len));
+        lens[s] = len;
+        ok = fp && len >= 0;
+    }
+    for(int s = 0; s < n_series && ok; ++s)
+    {
+        series[s] = new Dtype[lens[s] > 0 ? lens[s] : 1];
+        fp.read((char *)series[s], sizeof(Dtype) * lens[s]);
+        ok = bool(fp);
+    }
+    if(ok)
+    {
+        ok = series_batch_build(series, lens, n_series, batch);
+    }
+    else
+    {
+        cout << "Error: Batch file is truncated\n";
+    }
+    for(int s = 0; s < n_series; ++s) delete[] series[s];
+    delete[] series;
+    delete[] lens;
+    if(ok)
+    {
+        cout << "Read " << n_series << " series of up to " <<
+            batch.max_len << " values." << endl;
+    }
+    return ok;
+}
+
+
+/**
+  Write n_series random series of GEN_MIN_LEN to GEN_MAX_LEN values in
+  [-1, 1) to a batch file
+  */
+bool generate_batch_file(int n_series, const string batch_file)
+{
+    ofstream fp(batch_file, ios::binary);
+    if(!fp.is_open())
+    {
+        cout << "Could not open file for writing.\n";
+        return false;
+    }
+    int32_t n = n_series;
+    fp.write((const char *)&n, sizeof(n));
+    int32_t *lens = new int32_t[n_series > 0 ? n_series : 1];
+    for(int s = 0; s < n_series; ++s)
+    {
+        lens[s] = GEN_MIN_LEN + rand() % (GEN_MAX_LEN - GEN_MIN_LEN + 1);
+        fp.write((const char *)&lens[s], sizeof(lens[s]));
+    }
+    for(int s = 0; s < n_series; ++s)
+    {
+        for(int t = 0; t < lens[s]; ++t)
+        {
+            Dtype v = Dtype(rand()) / RAND_MAX * 2 - 1;
+            fp.write((const char *)&v, sizeof(v));
+        }
+    }
+    delete[] lens;
+    cout << "Written " << n_series << " series in " << batch_file << endl;
+    return true;
+}
+
+
+/**
+  Read series from terminal
+  */
+bool read_batch_term(SeriesBatch &batch)
+{
+    int n_series;
+    cout << "Enter number of series: ";
+    cin >> n_series;
+    if(n_series <= 0) return false;
+    int *lens = new int[n_series];
+    Dtype **series = new Dtype*[n_series]{};
+    for(int s = 0; s < n_series; ++s)
+    {
+        cout << "Enter the length of series " << s << ": ";
+        cin >> lens[s];
+        if(lens[s] < 0) lens[s] = 0;
+        series[s] = new Dtype[lens[s] > 0 ? lens[s] : 1];
+        cout << "Enter the values: ";
+        for(int t = 0; t < lens[s]; ++t) cin >> series[s][t];
+    }
+    bool ok = series_batch_build(series, lens, n_series, batch);
+    for(int s = 0; s < n_series; ++s) delete[] series[s];
+    delete[] series;
+    delete[] lens;
+    return ok;
+}
+
+
+/**
+  Prints usage
+  */
+void usage(const string command)
+{
+    cout << "Batch maximum subarray of many series. Usage:\n\n";
+    cout << "1. " << command << "\n   No input arguments. Reads all inputs from"\
+        " terminal.\n\n";
+    cout << "2. " << command << " -b <batch file> -o <output file> -c <1|0>" <<
+        endl;
+    cout << "   Finds the maximum subarray of each series of the binary batch"\
+        " file. The results are written as lines of \"begin end sum\" (1"\
+        " based, inclusive) to the output file, or printed. With -c 1, they"\
+        " are compared with find_max_subarray_faster on each series.\n\n";
+    cout << "3. " << command << " -g <number of series> -b <batch file>" <<
+        endl;
+    cout << "   Writes random series of " << GEN_MIN_LEN << " to " <<
+        GEN_MAX_LEN << " values.\n";
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc % 2 == 0)
+    {
+        usage(string(argv[0]));
+        return 0;
+    }
+    string batch_file = "", ofilename = "";
+    int n_generate = 0;
+    bool compare = false;
+    for(int i = 1; i < argc; i += 2)
+    {
+        string arg_opt {argv[i]};
+        if(arg_opt == "-h" || arg_opt == "--help")
+        {
+            usage(string(argv[0]));
+            return 0;
+        }
+        if(arg_opt == "-b" || arg_opt == "--batch") batch_file = argv[i + 1];
+        if(arg_opt == "-o" || arg_opt == "--output") ofilename = argv[i + 1];
+        if(arg_opt == "-g") n_generate = atoi(argv[i + 1]);
+        if(arg_opt == "-c") compare = atoi(argv[i + 1]) != 0;
+    }
+
+    if(n_generate > 0)
+    {
+        generate_batch_file(n_generate, batch_file);
+        return 0;
+    }
+
+    SeriesBatch batch = {0, 0, 0, nullptr, nullptr, nullptr, nullptr};
+    bool ok;
+    if(batch_file.empty())
+    {
+        ok = read_batch_term(batch);
+    }
+    else
+    {
+        ok = read_batch_file(batch_file, batch);
+    }
+    if(!ok)
+    {
+        series_batch_free(batch);
+        return 0;
+    }
+
+    const int n = batch.n_series;
+    int *beg = new int[n > 0 ? n : 1];
+    int *end = new int[n > 0 ? n : 1];
+    Dtype *sum = new Dtype[n > 0 ? n : 1];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    series_batch_kadane(batch, beg, end, sum);
+    chrono::duration<double> time = chrono::steady_clock::now() - t0;
+    cout << "Batch maximum subarray of " << n << " series took " <<
+        time.count() * 1000 << " ms." << endl;
+
+    if(compare)
+    {
+        //Kadane's algorithm on each series, copied back to an array of
+        //structures
+        size_t *offset = new size_t[n + 1];
+        offset[0] = 0;
+        for(int s = 0; s < n; ++s) offset[s + 1] = offset[s] + batch.lens[s];
+        Dtype *series = new Dtype[offset[n] + 1];
+        for(int s = 0; s < n; ++s)
+        {
+            const Dtype *block = batch.values + batch.block_off[s / LANES];
+            for(int t = 0; t < batch.lens[s]; ++t)
+            {
+                series[offset[s] + t] = block[t * LANES + s % LANES];
+            }
+        }
+        int *beg1 = new int[n > 0 ? n : 1];
+        int *end1 = new int[n > 0 ? n : 1];
+        Dtype *sum1 = new Dtype[n > 0 ? n : 1];
+        t0 = chrono::steady_clock::now();
+        for(int s = 0; s < n; ++s)
+        {
+            find_max_subarray_faster(series + offset[s], batch.lens[s],
+                    beg1[s], end1[s], sum1[s]);
+        }
+        time = chrono::steady_clock::now() - t0;
+        int n_diff = 0;
+        for(int s = 0; s < n; ++s)
+        {
+            if(beg1[s] != beg[s] || end1[s] != end[s] || sum1[s] != sum[s])
+            {
+                ++n_diff;
+            }
+        }
+        cout << "find_max_subarray_faster on each series took " <<
+            time.count() * 1000 << " ms. Different results: " << n_diff <<
+            endl;
+        delete[] series;
+        delete[] offset;
+        delete[] beg1;
+        delete[] end1;
+        delete[] sum1;
+    }
+
+    if(ofilename.empty())
+    {
+        cout << fixed;
+        for(int s = 0; s < n; ++s)
+        {
+            cout << "Series " << s << ": sum " << sum[s] << " at [" <<
+                beg[s] + 1 << ", " << end[s] << "]" << endl;
+        }
+    }
+    else
+    {
+        ofstream ofp(ofilename);
+        ofp << fixed;
+        for(int s = 0; s < n; ++s)
+        {
+            ofp << beg[s] + 1 << " " << end[s] << " " << sum[s] << endl;
+        }
+        cout << "Written " << n << " results in " << ofilename << endl;
+    }
+
+    series_batch_free(batch);
+    delete[] beg;
+    delete[] end;
+    delete[] sum;
+    return 0;
+}